@@ -8,6 +8,25 @@
 #include <numeric>
 #include <map>
 #include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+#include <thread>
+#include <chrono>
+#include <queue>
+#include <array>
+#include <cstdio>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <fstream>
+#include <functional>
+#include <variant>
+#include <cassert>
+#include <climits>
  
 using ll = long long;
 using ld = long double;
@@ -20,6 +39,65 @@ ld real_area() {
     return 0.5 * acos(0.0) + 1.25 * std::asin(0.8) - 1.0; // 2 * acos(0.0) = pi
 }
  
+//exact area of the intersection of m circles. the boundary is made of arcs of circle i
+//that lie inside every other circle; green's theorem turns the area into
+//0.5 * sum over arcs of integral (x dy - y dx) = 0.5 * (r^2 dt + cx r dsin - cy r dcos)
+ld exact_area(const roun* cs, int m) {
+    const ld pi = 4 * std::atan((ld)1);
+    ld res = 0;
+    for (int i = 0; i < m; ++i) {
+        std::vector<std::pair<ld, ld>> arcs = {{0, 2 * pi}};
+        for (int j = 0; j < m && !arcs.empty(); ++j) {
+            if (j == i) {
+                continue;
+            }
+            ld dx = cs[j].x - cs[i].x, dy = cs[j].y - cs[i].y;
+            ld d = std::sqrt(dx * dx + dy * dy);
+            if (d >= cs[i].r + cs[j].r) {
+                return 0;
+            }
+            //equal circles: only the first one keeps its boundary
+            if (d == 0 && cs[i].r == cs[j].r) {
+                if (j < i) {
+                    arcs.clear();
+                }
+                continue;
+            }
+            if (d + cs[i].r <= cs[j].r) {
+                continue;
+            }
+            if (d + cs[j].r <= cs[i].r) {
+                arcs.clear();
+                continue;
+            }
+            ld ca = (d * d + cs[i].r * cs[i].r - cs[j].r * cs[j].r) / (2 * d * cs[i].r);
+            ld al = std::acos(std::max<ld>(-1, std::min<ld>(1, ca)));
+            ld lo = std::atan2(dy, dx) - al;
+            lo -= 2 * pi * std::floor(lo / (2 * pi));
+            ld hi = lo + 2 * al;
+            std::vector<std::pair<ld, ld>> cut = {{lo, std::min(hi, 2 * pi)}};
+            if (hi > 2 * pi) {
+                cut.push_back({0, hi - 2 * pi});
+            }
+            std::vector<std::pair<ld, ld>> nw;
+            for (auto& p : arcs) {
+                for (auto& q : cut) {
+                    ld l = std::max(p.first, q.first), r = std::min(p.second, q.second);
+                    if (l < r) {
+                        nw.push_back({l, r});
+                    }
+                }
+            }
+            arcs.swap(nw);
+        }
+        for (auto& p : arcs) {
+            ld t1 = p.first, t2 = p.second;
+            res += cs[i].r * cs[i].r * (t2 - t1) + cs[i].x * cs[i].r * (std::sin(t2) - std::sin(t1)) - cs[i].y * cs[i].r * (std::cos(t2) - std::cos(t1));
+        }
+    }
+    return res / 2;
+}
+
 //narrow
 ld solve1(roun a, roun b, roun c, ll n) {
     ld minx = std::max(std::max(a.x - a.r, b.x - b.r), c.x - c.r);
@@ -87,28 +165,2603 @@ ld solve2(roun a, roun b, roun c, ll n) {
     }
     return s * (ld)k / (ld)n;
 }
-int main() {
-    srand(1);
-    std::ios_base::sync_with_stdio(false);
-    std::cin.tie(NULL);
-    roun a;
-    a.x = 1.0;
-    a.y = 1.0;
-    a.r = 1.0;
-    roun b;
-    b.x = 1.5;
-    b.y = 2.0;
-    b.r = std::sqrt(5.0)/ 2.0;
-    roun c;
-    c.x = 2.0;
-    c.y = 1.5;
-    c.r = std::sqrt(5.0) / 2.0;
-    ld real = real_area();
-    std::cout << std::fixed << std::setprecision(5);
+
+struct box {
+    ld minx, maxx, miny, maxy;
+};
+ 
+box narrow_box(const roun* cs, int m) {
+    box bx = {cs[0].x - cs[0].r, cs[0].x + cs[0].r, cs[0].y - cs[0].r, cs[0].y + cs[0].r};
+    for (int j = 1; j < m; ++j) {
+        bx.minx = std::max(bx.minx, cs[j].x - cs[j].r);
+        bx.maxx = std::min(bx.maxx, cs[j].x + cs[j].r);
+        bx.miny = std::max(bx.miny, cs[j].y - cs[j].r);
+        bx.maxy = std::min(bx.maxy, cs[j].y + cs[j].r);
+    }
+    return bx;
+}
+ 
+box wide_box(const roun* cs, int m) {
+    box bx = {cs[0].x - cs[0].r, cs[0].x + cs[0].r, cs[0].y - cs[0].r, cs[0].y + cs[0].r};
+    for (int j = 1; j < m; ++j) {
+        bx.minx = std::min(bx.minx, cs[j].x - cs[j].r);
+        bx.maxx = std::max(bx.maxx, cs[j].x + cs[j].r);
+        bx.miny = std::min(bx.miny, cs[j].y - cs[j].r);
+        bx.maxy = std::max(bx.maxy, cs[j].y + cs[j].r);
+    }
+    return bx;
+}
+ 
+//simd: 16 points per step from 16 xoshiro256+ lanes. lane t starts 2^128 steps after lane t - 1,
+//so lanes never overlap. all kernels walk the same lanes, so the cpu only changes speed, not the points
+const int LANES = 16;
+ 
+//s[w][t] - state word w of lane t, so one load gives the same word of 4 or 8 lanes
+struct lane_rng {
+    alignas(64) uint64_t s[4][LANES];
+};
+ 
+uint64_t splitmix(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+ 
+inline uint64_t xoshiro(uint64_t* s) {
+    uint64_t r = s[0] + s[3], t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+    return r;
+}
+ 
+//advance by 2^128 steps
+void xoshiro_jump(uint64_t* s) {
+    static const uint64_t JUMP[4] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+    uint64_t t[4] = {0, 0, 0, 0};
+    for (uint64_t j : JUMP) {
+        for (int b = 0; b < 64; ++b) {
+            if ((j >> b) & 1) {
+                for (int w = 0; w < 4; ++w) {
+                    t[w] ^= s[w];
+                }
+            }
+            xoshiro(s);
+        }
+    }
+    std::memcpy(s, t, sizeof(t));
+}
+ 
+lane_rng seed_lanes(uint64_t seed) {
+    lane_rng st;
+    uint64_t s[4];
+    for (int w = 0; w < 4; ++w) {
+        s[w] = splitmix(seed);
+    }
+    for (int t = 0; t < LANES; ++t) {
+        for (int w = 0; w < 4; ++w) {
+            st.s[w][t] = s[w];
+        }
+        xoshiro_jump(s);
+    }
+    return st;
+}
+ 
+//circle moved to box coordinates
+struct circ {
+    double x, y, r2;
+};
+ 
+inline uint64_t xorshift(uint64_t& s) {
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    return s;
+}
+ 
+//top 52 bits as mantissa of [1, 2), minus one
+inline double unit(uint64_t x) {
+    x = (x >> 12) | 0x3FF0000000000000ULL;
+    double d;
+    std::memcpy(&d, &x, sizeof(d));
+    return d - 1.0;
+}
+ 
+inline double lane_unit(lane_rng& st, int t) {
+    uint64_t s[4] = {st.s[0][t], st.s[1][t], st.s[2][t], st.s[3][t]};
+    double u = unit(xoshiro(s));
+    for (int w = 0; w < 4; ++w) {
+        st.s[w][t] = s[w];
+    }
+    return u;
+}
+ 
+ll hits_scalar(const circ* cs, int m, double w, double h, ll n, lane_rng& st) {
+    ll k = 0;
+    for (ll i = 0; i < n; i += LANES) {
+        ll cnt = std::min<ll>(LANES, n - i);
+        double dx[LANES], dy[LANES];
+        for (int t = 0; t < LANES; ++t) {
+            dx[t] = w * lane_unit(st, t);
+        }
+        for (int t = 0; t < LANES; ++t) {
+            dy[t] = h * lane_unit(st, t);
+        }
+        for (int t = 0; t < cnt; ++t) {
+            bool fl = 1;
+            for (int j = 0; j < m && fl; ++j) {
+                double qx = dx[t] - cs[j].x;
+                double qy = dy[t] - cs[j].y;
+                fl = qx * qx + qy * qy <= cs[j].r2;
+            }
+            k += fl;
+        }
+    }
+    return k;
+}
+ 
+//one xoshiro256+ step for 4 lanes, straight to doubles in [0, 1)
+__attribute__((target("avx2")))
+inline __m256d unit4(__m256i* s) {
+    __m256i r = _mm256_add_epi64(s[0], s[3]), t = _mm256_slli_epi64(s[1], 17);
+    s[2] = _mm256_xor_si256(s[2], s[0]);
+    s[3] = _mm256_xor_si256(s[3], s[1]);
+    s[1] = _mm256_xor_si256(s[1], s[2]);
+    s[0] = _mm256_xor_si256(s[0], s[3]);
+    s[2] = _mm256_xor_si256(s[2], t);
+    s[3] = _mm256_or_si256(_mm256_slli_epi64(s[3], 45), _mm256_srli_epi64(s[3], 19));
+    __m256i x = _mm256_or_si256(_mm256_srli_epi64(r, 12), _mm256_set1_epi64x(0x3FF0000000000000LL));
+    return _mm256_sub_pd(_mm256_castsi256_pd(x), _mm256_set1_pd(1.0));
+}
+ 
+__attribute__((target("avx2")))
+void load4(__m256i s[4][4], const lane_rng& st) {
+    for (int g = 0; g < 4; ++g) {
+        for (int w = 0; w < 4; ++w) {
+            s[g][w] = _mm256_load_si256((const __m256i*)(st.s[w] + 4 * g));
+        }
+    }
+}
+ 
+__attribute__((target("avx2")))
+void store4(__m256i s[4][4], lane_rng& st) {
+    for (int g = 0; g < 4; ++g) {
+        for (int w = 0; w < 4; ++w) {
+            _mm256_store_si256((__m256i*)(st.s[w] + 4 * g), s[g][w]);
+        }
+    }
+}
+ 
+__attribute__((target("avx2")))
+ll hits_avx2(const circ* cs, int m, double w, double h, ll n, lane_rng& st) {
+    __m256i s[4][4];
+    load4(s, st);
+    __m256d vw = _mm256_set1_pd(w), vh = _mm256_set1_pd(h);
+    ll k = 0;
+    for (ll i = 0; i < n; i += LANES) {
+        __m256d dx[4], dy[4];
+        for (int g = 0; g < 4; ++g) {
+            dx[g] = _mm256_mul_pd(vw, unit4(s[g]));
+        }
+        for (int g = 0; g < 4; ++g) {
+            dy[g] = _mm256_mul_pd(vh, unit4(s[g]));
+        }
+        unsigned bits = 0;
+        for (int g = 0; g < 4; ++g) {
+            __m256d in = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+            for (int j = 0; j < m; ++j) {
+                __m256d qx = _mm256_sub_pd(dx[g], _mm256_set1_pd(cs[j].x));
+                __m256d qy = _mm256_sub_pd(dy[g], _mm256_set1_pd(cs[j].y));
+                __m256d d = _mm256_add_pd(_mm256_mul_pd(qx, qx), _mm256_mul_pd(qy, qy));
+                in = _mm256_and_pd(in, _mm256_cmp_pd(d, _mm256_set1_pd(cs[j].r2), _CMP_LE_OQ));
+                if (_mm256_testz_pd(in, in)) {
+                    break;
+                }
+            }
+            bits |= (unsigned)_mm256_movemask_pd(in) << (4 * g);
+        }
+        if (n - i < LANES) {
+            bits &= (1u << (n - i)) - 1;
+        }
+        k += __builtin_popcount(bits);
+    }
+    store4(s, st);
+    return k;
+}
+ 
+__attribute__((target("avx512f")))
+inline __m512d unit8(__m512i* s) {
+    __m512i r = _mm512_add_epi64(s[0], s[3]), t = _mm512_slli_epi64(s[1], 17);
+    s[2] = _mm512_xor_si512(s[2], s[0]);
+    s[3] = _mm512_xor_si512(s[3], s[1]);
+    s[1] = _mm512_xor_si512(s[1], s[2]);
+    s[0] = _mm512_xor_si512(s[0], s[3]);
+    s[2] = _mm512_xor_si512(s[2], t);
+    s[3] = _mm512_rol_epi64(s[3], 45);
+    __m512i x = _mm512_or_si512(_mm512_srli_epi64(r, 12), _mm512_set1_epi64(0x3FF0000000000000LL));
+    return _mm512_sub_pd(_mm512_castsi512_pd(x), _mm512_set1_pd(1.0));
+}
+ 
+__attribute__((target("avx512f")))
+void load8(__m512i s[2][4], const lane_rng& st) {
+    for (int g = 0; g < 2; ++g) {
+        for (int w = 0; w < 4; ++w) {
+            s[g][w] = _mm512_load_si512((const void*)(st.s[w] + 8 * g));
+        }
+    }
+}
+ 
+__attribute__((target("avx512f")))
+void store8(__m512i s[2][4], lane_rng& st) {
+    for (int g = 0; g < 2; ++g) {
+        for (int w = 0; w < 4; ++w) {
+            _mm512_store_si512((void*)(st.s[w] + 8 * g), s[g][w]);
+        }
+    }
+}
+ 
+__attribute__((target("avx512f")))
+ll hits_avx512(const circ* cs, int m, double w, double h, ll n, lane_rng& st) {
+    __m512i s[2][4];
+    load8(s, st);
+    __m512d vw = _mm512_set1_pd(w), vh = _mm512_set1_pd(h);
+    ll k = 0;
+    for (ll i = 0; i < n; i += LANES) {
+        __m512d dx[2], dy[2];
+        for (int g = 0; g < 2; ++g) {
+            dx[g] = _mm512_mul_pd(vw, unit8(s[g]));
+        }
+        for (int g = 0; g < 2; ++g) {
+            dy[g] = _mm512_mul_pd(vh, unit8(s[g]));
+        }
+        unsigned bits = 0;
+        for (int g = 0; g < 2; ++g) {
+            __mmask8 in = 0xFF;
+            for (int j = 0; j < m; ++j) {
+                __m512d qx = _mm512_sub_pd(dx[g], _mm512_set1_pd(cs[j].x));
+                __m512d qy = _mm512_sub_pd(dy[g], _mm512_set1_pd(cs[j].y));
+                __m512d d = _mm512_add_pd(_mm512_mul_pd(qx, qx), _mm512_mul_pd(qy, qy));
+                in = _mm512_mask_cmp_pd_mask(in, d, _mm512_set1_pd(cs[j].r2), _CMP_LE_OQ);
+                if (!in) {
+                    break;
+                }
+            }
+            bits |= (unsigned)in << (8 * g);
+        }
+        if (n - i < LANES) {
+            bits &= (1u << (n - i)) - 1;
+        }
+        k += __builtin_popcount(bits);
+    }
+    store8(s, st);
+    return k;
+}
+ 
+//plain uniform doubles for loops that are not one of the kernels above.
+//writes cnt rounded up to LANES values, one step of all lanes at a time
+void fill_scalar(lane_rng& st, double* out, ll cnt) {
+    for (ll i = 0; i < cnt; i += LANES) {
+        for (int t = 0; t < LANES; ++t) {
+            out[i + t] = lane_unit(st, t);
+        }
+    }
+}
+ 
+__attribute__((target("avx2")))
+void fill_avx2(lane_rng& st, double* out, ll cnt) {
+    __m256i s[4][4];
+    load4(s, st);
+    for (ll i = 0; i < cnt; i += LANES) {
+        for (int g = 0; g < 4; ++g) {
+            _mm256_storeu_pd(out + i + 4 * g, unit4(s[g]));
+        }
+    }
+    store4(s, st);
+}
+ 
+__attribute__((target("avx512f")))
+void fill_avx512(lane_rng& st, double* out, ll cnt) {
+    __m512i s[2][4];
+    load8(s, st);
+    for (ll i = 0; i < cnt; i += LANES) {
+        for (int g = 0; g < 2; ++g) {
+            _mm512_storeu_pd(out + i + 8 * g, unit8(s[g]));
+        }
+    }
+    store8(s, st);
+}
+ 
+//runtime dispatch: the widest of the variants the cpu supports
+template <class F>
+F pick(F avx512, F avx2, F scalar) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return avx2;
+    }
+    return scalar;
+}
+ 
+using fill_fn = void (*)(lane_rng&, double*, ll);
+ 
+void fill_uniform(lane_rng& st, double* out, ll cnt) {
+    static const fill_fn fill = pick<fill_fn>(fill_avx512, fill_avx2, fill_scalar);
+    fill(st, out, cnt);
+}
+ 
+using hits_fn = ll (*)(const circ*, int, double, double, ll, lane_rng&);
+ 
+//circles ordered by how often each one rejects a pilot sample from the box, most first
+std::vector<int> reject_order(const roun* cs, int m, box bx, uint64_t seed, int pilot = 4096) {
+    std::vector<ll> miss(m, 0);
+    uint64_t st = splitmix(seed) | 1;
+    for (int i = 0; i < pilot; ++i) {
+        double u = unit(xorshift(st)), v = unit(xorshift(st));
+        ld x = bx.minx + (bx.maxx - bx.minx) * u, y = bx.miny + (bx.maxy - bx.miny) * v;
+        for (int j = 0; j < m; ++j) {
+            ld qx = x - cs[j].x, qy = y - cs[j].y;
+            miss[j] += qx * qx + qy * qy > cs[j].r * cs[j].r;
+        }
+    }
+    std::vector<int> order(m);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int i, int j) {
+        return miss[i] > miss[j];
+    });
+    return order;
+}
+ 
+std::vector<circ> to_box(const roun* cs, int m, box bx, uint64_t seed) {
+    std::vector<circ> q;
+    for (int j : reject_order(cs, m, bx, seed)) {
+        q.push_back({(double)(cs[j].x - bx.minx), (double)(cs[j].y - bx.miny), (double)(cs[j].r * cs[j].r)});
+    }
+    return q;
+}
+ 
+ld solve_simd(const roun* cs, int m, box bx, ll n, uint64_t seed) {
+    if (bx.maxx <= bx.minx || bx.maxy <= bx.miny || n <= 0) {
+        return 0;
+    }
+    static const hits_fn hits = pick<hits_fn>(hits_avx512, hits_avx2, hits_scalar);
+    std::vector<circ> q = to_box(cs, m, bx, seed);
+    lane_rng st = seed_lanes(seed);
+    ll k = hits(q.data(), m, (double)(bx.maxx - bx.minx), (double)(bx.maxy - bx.miny), n, st);
+    return (bx.maxx - bx.minx) * (bx.maxy - bx.miny) * (ld)k / (ld)n;
+}
+ 
+ld solve1_simd(roun a, roun b, roun c, ll n, uint64_t seed = 1) {
+    roun cs[3] = {a, b, c};
+    return solve_simd(cs, 3, narrow_box(cs, 3), n, seed);
+}
+ 
+ld solve2_simd(roun a, roun b, roun c, ll n, uint64_t seed = 1) {
+    roun cs[3] = {a, b, c};
+    return solve_simd(cs, 3, wide_box(cs, 3), n, seed);
+}
+
+//sequential stopping: sample in batches until the wilson interval on the hit ratio
+//is within rel of the estimate at confidence conf (or max_n points were used)
+ld normal_quantile(ld conf) {
+    //two-sided: find z with P(|Z| <= z) = conf
+    ld lo = 0, hi = 40;
+    for (int it = 0; it < 200; ++it) {
+        ld mid = (lo + hi) / 2;
+        if (std::erf(mid / std::sqrt((ld)2)) < conf) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo + hi) / 2;
+}
+ 
+struct seq_result {
+    ld area, lo, hi;
+    ll n;
+    double sec;
+};
+ 
+seq_result solve_seq(const roun* cs, int m, box bx, ld rel, ld conf, uint64_t seed, ll batch = 4096, ll max_n = 1LL << 40) {
+    auto start = std::chrono::steady_clock::now();
+    seq_result res = {0, 0, 0, 0, 0};
+    if (bx.maxx <= bx.minx || bx.maxy <= bx.miny) {
+        return res;
+    }
+    static const hits_fn hits = pick<hits_fn>(hits_avx512, hits_avx2, hits_scalar);
+    std::vector<circ> q = to_box(cs, m, bx, seed);
+    lane_rng st = seed_lanes(seed);
+    ld s = (bx.maxx - bx.minx) * (bx.maxy - bx.miny);
+    ld z = normal_quantile(conf);
+    batch = std::max<ll>(LANES, batch / LANES * LANES);
+    ll n = 0, k = 0;
+    while (n < max_n) {
+        ll cnt = std::min(batch, max_n - n);
+        k += hits(q.data(), m, (double)(bx.maxx - bx.minx), (double)(bx.maxy - bx.miny), cnt, st);
+        n += cnt;
+        ld p = (ld)k / n, d = 1 + z * z / n;
+        ld mid = (p + z * z / (2 * n)) / d;
+        ld half = z / d * std::sqrt(p * (1 - p) / n + z * z / (4.0L * n * n));
+        res.area = s * p;
+        res.lo = s * (mid - half);
+        res.hi = s * (mid + half);
+        if (k > 0 && half <= rel * mid) {
+            break;
+        }
+    }
+    res.n = n;
+    res.sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
+ 
+seq_result solve1_seq(roun a, roun b, roun c, ld rel, ld conf = 0.95, uint64_t seed = 1) {
+    roun cs[3] = {a, b, c};
+    return solve_seq(cs, 3, narrow_box(cs, 3), rel, conf, seed);
+}
+ 
+seq_result solve2_seq(roun a, roun b, roun c, ld rel, ld conf = 0.95, uint64_t seed = 1) {
+    roun cs[3] = {a, b, c};
+    return solve_seq(cs, 3, wide_box(cs, 3), rel, conf, seed);
+}
+
+//parameter sweep: many configurations of m circles (config c is cs[c * m .. c * m + m)) against
+//one shared pool of points. the pool lives in the union of the narrow boxes and is drawn block by
+//block; a block is tested against every configuration while it is still in cache.
+//all estimates share the points, so differences between configurations are much less noisy
+ll pool_scalar(const circ* cs, int m, const double* x, const double* y, int cnt) {
+    ll k = 0;
+    for (int i = 0; i < cnt; ++i) {
+        bool fl = 1;
+        for (int j = 0; j < m; ++j) {
+            double qx = x[i] - cs[j].x, qy = y[i] - cs[j].y;
+            fl &= qx * qx + qy * qy <= cs[j].r2;
+        }
+        k += fl;
+    }
+    return k;
+}
+ 
+__attribute__((target("avx2")))
+ll pool_avx2(const circ* cs, int m, const double* x, const double* y, int cnt) {
+    ll k = 0;
+    int i = 0;
+    for (; i + 4 <= cnt; i += 4) {
+        __m256d px = _mm256_loadu_pd(x + i), py = _mm256_loadu_pd(y + i);
+        __m256d in = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        for (int j = 0; j < m; ++j) {
+            __m256d qx = _mm256_sub_pd(px, _mm256_set1_pd(cs[j].x));
+            __m256d qy = _mm256_sub_pd(py, _mm256_set1_pd(cs[j].y));
+            __m256d d = _mm256_add_pd(_mm256_mul_pd(qx, qx), _mm256_mul_pd(qy, qy));
+            in = _mm256_and_pd(in, _mm256_cmp_pd(d, _mm256_set1_pd(cs[j].r2), _CMP_LE_OQ));
+        }
+        k += __builtin_popcount(_mm256_movemask_pd(in));
+    }
+    return k + pool_scalar(cs, m, x + i, y + i, cnt - i);
+}
+ 
+__attribute__((target("avx512f")))
+ll pool_avx512(const circ* cs, int m, const double* x, const double* y, int cnt) {
+    ll k = 0;
+    for (int i = 0; i < cnt; i += 8) {
+        __mmask8 in = cnt - i >= 8 ? 0xFF : (__mmask8)((1u << (cnt - i)) - 1);
+        __m512d px = _mm512_maskz_loadu_pd(in, x + i), py = _mm512_maskz_loadu_pd(in, y + i);
+        for (int j = 0; j < m; ++j) {
+            __m512d qx = _mm512_sub_pd(px, _mm512_set1_pd(cs[j].x));
+            __m512d qy = _mm512_sub_pd(py, _mm512_set1_pd(cs[j].y));
+            __m512d d = _mm512_add_pd(_mm512_mul_pd(qx, qx), _mm512_mul_pd(qy, qy));
+            in = _mm512_mask_cmp_pd_mask(in, d, _mm512_set1_pd(cs[j].r2), _CMP_LE_OQ);
+        }
+        k += __builtin_popcount(in);
+    }
+    return k;
+}
+ 
+using pool_fn = ll (*)(const circ*, int, const double*, const double*, int);
+ 
+//each thread draws its own share of the pool from its own lanes: reproducible for a given seed and thread count
+std::vector<ld> solve_sweep(const roun* cs, int m, int cfgs, ll n, uint64_t seed, int threads = 0) {
+    std::vector<ld> res(cfgs, 0);
+    box bx = {1e300L, -1e300L, 1e300L, -1e300L};
+    for (int c = 0; c < cfgs; ++c) {
+        box z = narrow_box(cs + c * m, m);
+        if (z.maxx > z.minx && z.maxy > z.miny) {
+            bx = {std::min(bx.minx, z.minx), std::max(bx.maxx, z.maxx), std::min(bx.miny, z.miny), std::max(bx.maxy, z.maxy)};
+        }
+    }
+    if (bx.maxx <= bx.minx || n <= 0) {
+        return res;
+    }
+    std::vector<circ> q(cfgs * m);
+    for (int i = 0; i < cfgs * m; ++i) {
+        q[i] = {(double)(cs[i].x - bx.minx), (double)(cs[i].y - bx.miny), (double)(cs[i].r * cs[i].r)};
+    }
+    static const pool_fn pool = pick<pool_fn>(pool_avx512, pool_avx2, pool_scalar);
+    double w = bx.maxx - bx.minx, h = bx.maxy - bx.miny;
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::vector<std::vector<ll>> part(threads, std::vector<ll>(cfgs, 0));
+    std::vector<std::thread> th;
+    for (int t = 0; t < threads; ++t) {
+        th.emplace_back([&, t]() {
+            const int B = 2048;
+            uint64_t sd = seed ^ (0x9E3779B97F4A7C15ULL * (t + 1));
+            lane_rng st = seed_lanes(splitmix(sd));
+            std::vector<double> x(B), y(B);
+            for (ll i = n * t / threads, to = n * (t + 1) / threads; i < to; i += B) {
+                int cnt = std::min<ll>(B, to - i);
+                fill_uniform(st, x.data(), cnt);
+                fill_uniform(st, y.data(), cnt);
+                for (int j = 0; j < cnt; ++j) {
+                    x[j] *= w;
+                    y[j] *= h;
+                }
+                for (int c = 0; c < cfgs; ++c) {
+                    part[t][c] += pool(q.data() + c * m, m, x.data(), y.data(), cnt);
+                }
+            }
+        });
+    }
+    for (std::thread& x : th) {
+        x.join();
+    }
+    for (int c = 0; c < cfgs; ++c) {
+        ll k = 0;
+        for (int t = 0; t < threads; ++t) {
+            k += part[t][c];
+        }
+        res[c] = w * h * (ld)k / n;
+    }
+    return res;
+}
+
+//d dimensions: spheres with std::array centers, the narrow box and the stratified strategy.
+//points go in SoA blocks (coordinate d of point i at d * stride + i). the distance kernel is written
+//once with 64-byte gcc vector types, instantiated per instruction set and picked at runtime
+template <class T, int D>
+struct sphere {
+    std::array<T, D> c;
+    T r;
+};
+ 
+template <class T, int D>
+struct dbox {
+    std::array<T, D> lo, hi;
+ 
+    ld volume() const {
+        ld v = 1;
+        for (int d = 0; d < D; ++d) {
+            v *= std::max<ld>(0, hi[d] - lo[d]);
+        }
+        return v;
+    }
+};
+ 
+template <class T, int D>
+dbox<T, D> narrow_dbox(const sphere<T, D>* sp, int m) {
+    dbox<T, D> b;
+    for (int d = 0; d < D; ++d) {
+        b.lo[d] = sp[0].c[d] - sp[0].r;
+        b.hi[d] = sp[0].c[d] + sp[0].r;
+        for (int j = 1; j < m; ++j) {
+            b.lo[d] = std::max(b.lo[d], sp[j].c[d] - sp[j].r);
+            b.hi[d] = std::min(b.hi[d], sp[j].c[d] + sp[j].r);
+        }
+    }
+    return b;
+}
+ 
+template <class T, int D>
+__attribute__((always_inline)) inline ll dhits_block(const sphere<T, D>* sp, int m, const T* pts, int stride, int cnt) {
+    typedef T vec __attribute__((vector_size(64)));
+    const int W = 64 / sizeof(T);
+    ll k = 0;
+    for (int i = 0; i < cnt; i += W) {
+        vec p[D];
+        for (int d = 0; d < D; ++d) {
+            std::memcpy(&p[d], pts + d * stride + i, sizeof(vec));
+        }
+        auto in = p[0] == p[0];
+        for (int j = 0; j < m; ++j) {
+            vec acc = p[0] - p[0];
+            for (int d = 0; d < D; ++d) {
+                vec q = p[d] - sp[j].c[d];
+                acc += q * q;
+            }
+            in &= acc <= sp[j].r * sp[j].r;
+        }
+        for (int l = 0; l < W && i + l < cnt; ++l) {
+            k += in[l] != 0;
+        }
+    }
+    return k;
+}
+ 
+template <class T, int D>
+__attribute__((target("avx512f"))) ll dhits_avx512(const sphere<T, D>* sp, int m, const T* pts, int stride, int cnt) {
+    return dhits_block<T, D>(sp, m, pts, stride, cnt);
+}
+ 
+template <class T, int D>
+__attribute__((target("avx2"))) ll dhits_avx2(const sphere<T, D>* sp, int m, const T* pts, int stride, int cnt) {
+    return dhits_block<T, D>(sp, m, pts, stride, cnt);
+}
+ 
+template <class T, int D>
+ll dhits_scalar(const sphere<T, D>* sp, int m, const T* pts, int stride, int cnt) {
+    return dhits_block<T, D>(sp, m, pts, stride, cnt);
+}
+ 
+template <class T, int D>
+ll dhits(const sphere<T, D>* sp, int m, const T* pts, int stride, int cnt) {
+    using fn = ll (*)(const sphere<T, D>*, int, const T*, int, int);
+    static const fn f = pick<fn>(dhits_avx512<T, D>, dhits_avx2<T, D>, dhits_scalar<T, D>);
+    return f(sp, m, pts, stride, cnt);
+}
+ 
+//hits among n uniform points of b; spheres are moved to b.lo so float keeps its digits
+template <class T, int D>
+ll dsample(const sphere<T, D>* sp, int m, const dbox<T, D>& b, ll n, lane_rng& st) {
+    const int B = 1024;
+    std::vector<sphere<T, D>> rel(sp, sp + m);
+    for (auto& z : rel) {
+        for (int d = 0; d < D; ++d) {
+            z.c[d] -= b.lo[d];
+        }
+    }
+    std::vector<double> u(B);
+    std::vector<T> pts(D * B);
+    ll k = 0;
+    for (ll i = 0; i < n; i += B) {
+        int cnt = std::min<ll>(B, n - i);
+        for (int d = 0; d < D; ++d) {
+            fill_uniform(st, u.data(), cnt);
+            T w = b.hi[d] - b.lo[d];
+            for (int l = 0; l < cnt; ++l) {
+                pts[d * B + l] = (T)u[l] * w;
+            }
+        }
+        k += dhits<T, D>(rel.data(), m, pts.data(), B, cnt);
+    }
+    return k;
+}
+ 
+template <class T, int D>
+ld dsolve_narrow(const sphere<T, D>* sp, int m, ll n, uint64_t seed) {
+    dbox<T, D> b = narrow_dbox(sp, m);
+    ld v = b.volume();
+    if (v == 0 || n <= 0) {
+        return 0;
+    }
+    lane_rng st = seed_lanes(seed);
+    return v * (ld)dsample(sp, m, b, n, st) / n;
+}
+ 
+//1 inside all, -1 outside some, 0 straddles
+template <class T, int D>
+int dclassify(const sphere<T, D>* sp, int m, const dbox<T, D>& b) {
+    bool all = 1;
+    for (int j = 0; j < m; ++j) {
+        ld nr = 0, fr = 0;
+        for (int d = 0; d < D; ++d) {
+            ld c = sp[j].c[d], lo = b.lo[d], hi = b.hi[d];
+            ld nd = c < lo ? lo - c : c > hi ? c - hi : 0;
+            ld fd = std::max(std::abs(c - lo), std::abs(c - hi));
+            nr += nd * nd;
+            fr += fd * fd;
+        }
+        ld r2 = (ld)sp[j].r * sp[j].r;
+        if (nr > r2) {
+            return -1;
+        }
+        all &= fr <= r2;
+    }
+    return all ? 1 : 0;
+}
+ 
+//2^D children are out of the question for D = 16, so cells are halved along their longest side;
+//cells on one level stay congruent and share the samples evenly. past D ~ 10 a sample budget only
+//buys a few halvings per axis and the hits get rare, dsolve_ball is the better choice there
+template <class T, int D>
+ld dsolve_strat(const sphere<T, D>* sp, int m, ll n, uint64_t seed, int per_cell = 8) {
+    dbox<T, D> root = narrow_dbox(sp, m);
+    if (root.volume() == 0 || n <= 0) {
+        return 0;
+    }
+    ld res = 0;
+    std::vector<dbox<T, D>> cur = {root}, nxt;
+    if (dclassify(sp, m, root) != 0) {
+        return dclassify(sp, m, root) == 1 ? root.volume() : 0;
+    }
+    for (int depth = 0; depth < 64 && (ll)cur.size() * 2 * per_cell <= n; ++depth) {
+        int ax = 0;
+        for (int d = 1; d < D; ++d) {
+            if (cur[0].hi[d] - cur[0].lo[d] > cur[0].hi[ax] - cur[0].lo[ax]) {
+                ax = d;
+            }
+        }
+        nxt.clear();
+        for (const auto& q : cur) {
+            T mid = (q.lo[ax] + q.hi[ax]) / 2;
+            dbox<T, D> l = q, r = q;
+            l.hi[ax] = mid;
+            r.lo[ax] = mid;
+            for (const auto& z : {l, r}) {
+                int t = dclassify(sp, m, z);
+                if (t == 1) {
+                    res += z.volume();
+                } else if (t == 0) {
+                    nxt.push_back(z);
+                }
+            }
+        }
+        cur.swap(nxt);
+        if (cur.empty()) {
+            return res;
+        }
+    }
+    lane_rng st = seed_lanes(seed);
+    ll cells = cur.size();
+    for (ll t = 0; t < cells; ++t) {
+        ll cnt = n / cells + (t < n % cells);
+        if (cnt > 0) {
+            res += cur[t].volume() * (ld)dsample(sp, m, cur[t], cnt, st) / cnt;
+        }
+    }
+    return res;
+}
+ 
+//in high dimensions the narrow box is mostly corners; uniform points in the smallest ball
+//(gaussian direction, radius r u^(1/D)) hit far more often, each weighted by the ball volume
+template <class T, int D>
+ld dsolve_ball(const sphere<T, D>* sp, int m, ll n, uint64_t seed) {
+    const ld pi = 4 * std::atan((ld)1);
+    int s0 = 0;
+    for (int j = 1; j < m; ++j) {
+        if (sp[j].r < sp[s0].r) {
+            s0 = j;
+        }
+    }
+    if (n <= 0) {
+        return 0;
+    }
+    std::vector<sphere<T, D>> rel(sp, sp + m);
+    for (auto& z : rel) {
+        for (int d = 0; d < D; ++d) {
+            z.c[d] -= sp[s0].c[d];
+        }
+    }
+    const int B = 1024;
+    lane_rng st = seed_lanes(seed);
+    std::vector<double> u(2 * B), nrm(B), pts(D * B);
+    std::vector<T> tp(D * B);
+    ll k = 0;
+    for (ll i = 0; i < n; i += B) {
+        int cnt = std::min<ll>(B, n - i);
+        std::fill(nrm.begin(), nrm.end(), 0.0);
+        for (int d = 0; d < D; ++d) {
+            fill_uniform(st, u.data(), 2 * cnt);
+            for (int l = 0; l < cnt; ++l) {
+                double g = std::sqrt(-2 * std::log(1 - u[2 * l])) * std::cos(2 * (double)pi * u[2 * l + 1]);
+                pts[d * B + l] = g;
+                nrm[l] += g * g;
+            }
+        }
+        fill_uniform(st, u.data(), cnt);
+        for (int l = 0; l < cnt; ++l) {
+            nrm[l] = sp[s0].r * std::pow(u[l], 1.0 / D) / std::sqrt(nrm[l]);
+        }
+        for (int d = 0; d < D; ++d) {
+            for (int l = 0; l < cnt; ++l) {
+                tp[d * B + l] = (T)(pts[d * B + l] * nrm[l]);
+            }
+        }
+        k += dhits<T, D>(rel.data(), m, tp.data(), B, cnt);
+    }
+    ld vol = std::exp(D / 2.0L * std::log(pi) - std::lgamma(D / 2.0L + 1)) * std::pow((ld)sp[s0].r, D);
+    return vol * k / n;
+}
+ 
+//three unit spheres at 0, e0 / 2, e1 / 2: throughput of the narrow estimator and both estimates
+template <int D>
+void dim_report(ll n) {
+    sphere<double, D> sp[3];
+    for (int j = 0; j < 3; ++j) {
+        sp[j].c.fill(0);
+        sp[j].r = 1;
+    }
+    sp[1].c[0] = 0.5;
+    sp[2].c[1] = 0.5;
+    auto t0 = std::chrono::steady_clock::now();
+    ld vn = dsolve_narrow<double, D>(sp, 3, n, D);
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    ld vs = dsolve_strat<double, D>(sp, 3, n, D, 64);
+    ld vb = dsolve_ball<double, D>(sp, 3, n, D);
+    std::cout << D << "," << n << "," << sec << "," << n / sec / 1e6 << "," << sec / n * 1e9 << std::scientific << "," << vn << "," << vs << "," << vb << std::fixed << '\n';
+}
+
+//philox4x32-10: the i-th point depends only on (seed, i), so jump-ahead is just moving the counter
+struct philox {
+    uint32_t k0, k1;
+    uint64_t ctr;
+ 
+    philox(uint64_t seed, uint64_t start = 0) : k0((uint32_t)seed), k1((uint32_t)(seed >> 32)), ctr(start) {
+    }
+ 
+    void jump(uint64_t d) {
+        ctr += d;
+    }
+ 
+    void next(uint32_t out[4]) {
+        uint32_t c0 = (uint32_t)ctr, c1 = (uint32_t)(ctr >> 32), c2 = 0, c3 = 0;
+        uint32_t a = k0, b = k1;
+        for (int r = 0; r < 10; ++r) {
+            uint64_t p0 = (uint64_t)0xD2511F53u * c0;
+            uint64_t p1 = (uint64_t)0xCD9E8D57u * c2;
+            c0 = (uint32_t)(p1 >> 32) ^ c1 ^ a;
+            c1 = (uint32_t)p1;
+            c2 = (uint32_t)(p0 >> 32) ^ c3 ^ b;
+            c3 = (uint32_t)p0;
+            a += 0x9E3779B9u;
+            b += 0xBB67AE85u;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+        ++ctr;
+    }
+ 
+    //one block per point: 64 bits for x, 64 bits for y
+    void point(double& u, double& v) {
+        uint32_t w[4];
+        next(w);
+        u = unit(((uint64_t)w[0] << 32) | w[1]);
+        v = unit(((uint64_t)w[2] << 32) | w[3]);
+    }
+};
+ 
+bool inside(const roun* cs, int m, ld x, ld y) {
+    for (int j = 0; j < m; ++j) {
+        ld qx = x - cs[j].x;
+        ld qy = y - cs[j].y;
+        if (qx * qx + qy * qy > cs[j].r * cs[j].r) {
+            return 0;
+        }
+    }
+    return 1;
+}
+ 
+//gen is any point generator with a (seed, start index) constructor: philox, sobol2, halton2.
+//point i is the same whichever range asks for it, so hits over a split of [0, n) add up exactly
+template <class gen>
+ll hits_range(const roun* cs, int m, box bx, uint64_t seed, ll from, ll to) {
+    gen g(seed, from);
+    ll k = 0;
+    for (ll i = from; i < to; ++i) {
+        double u, v;
+        g.point(u, v);
+        if (inside(cs, m, bx.minx + (bx.maxx - bx.minx) * u, bx.miny + (bx.maxy - bx.miny) * v)) {
+            k++;
+        }
+    }
+    return k;
+}
+ 
+//each thread takes a contiguous block [from, to) of point indices and runs f(from, to) once;
+//the results (a hit count, or anything with +=) are summed in thread order
+template <class F>
+auto parallel_hits(ll n, int threads, F f) -> decltype(f(0LL, 0LL)) {
+    using R = decltype(f(0LL, 0LL));
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::vector<R> part(threads, R{});
+    std::vector<std::thread> th;
+    for (int t = 0; t < threads; ++t) {
+        ll from = n * t / threads, to = n * (t + 1) / threads;
+        th.emplace_back([&part, &f, t, from, to]() {
+            part[t] = f(from, to);
+        });
+    }
+    for (std::thread& x : th) {
+        x.join();
+    }
+    R sum{};
+    for (const R& x : part) {
+        sum += x;
+    }
+    return sum;
+}
+ 
+//hits_range numbers the points globally and hits are integers, so the result does not depend
+//on the thread count at all
+template <class gen>
+ld solve_mt(const roun* cs, int m, box bx, ll n, uint64_t seed, int threads) {
+    if (bx.maxx <= bx.minx || bx.maxy <= bx.miny || n <= 0) {
+        return 0;
+    }
+    ll k = parallel_hits(n, threads, [&](ll from, ll to) {
+        return hits_range<gen>(cs, m, bx, seed, from, to);
+    });
+    return (bx.maxx - bx.minx) * (bx.maxy - bx.miny) * (ld)k / (ld)n;
+}
+ 
+ld solve1_mt(roun a, roun b, roun c, ll n, uint64_t seed = 1, int threads = 0) {
+    roun cs[3] = {a, b, c};
+    return solve_mt<philox>(cs, 3, narrow_box(cs, 3), n, seed, threads);
+}
+ 
+ld solve2_mt(roun a, roun b, roun c, ll n, uint64_t seed = 1, int threads = 0) {
+    roun cs[3] = {a, b, c};
+    return solve_mt<philox>(cs, 3, wide_box(cs, 3), n, seed, threads);
+}
+
+//deterministic: at every x the intersection is the y-interval common to all chords,
+//so area = integral of its length over x. the length has kinks where a circle starts or ends
+//and where the active boundary switches (pairwise intersection points); those become breakpoints.
+//between breakpoints x = p + (q - p)(3t^2 - 2t^3) removes the sqrt endpoint behaviour,
+//and the pieces are integrated with globally adaptive gauss-kronrod 7-15
+ld slice_len(const roun* cs, int m, ld x) {
+    ld lo = -1e300L, hi = 1e300L;
+    for (int j = 0; j < m; ++j) {
+        ld dx = x - cs[j].x, h2 = cs[j].r * cs[j].r - dx * dx;
+        if (h2 <= 0) {
+            return 0;
+        }
+        ld h = std::sqrt(h2);
+        lo = std::max(lo, cs[j].y - h);
+        hi = std::min(hi, cs[j].y + h);
+    }
+    return std::max<ld>(0, hi - lo);
+}
+ 
+const ld GK_X[8] = {0.991455371120812639206854697526329L, 0.949107912342758524526189684047851L, 0.864864423359769072789712788640926L, 0.741531185599394439863864773280788L,
+                    0.586087235467691130294144845693013L, 0.405845151377397166906606412076961L, 0.207784955007898467600689403773245L, 0};
+const ld GK_W[8] = {0.022935322010529224963732008058970L, 0.063092092629978553290700663189204L, 0.104790010322250183839876322541518L, 0.140653259715525918745189590510238L,
+                    0.169004726639267902826583426598550L, 0.190350578064785409913256402421014L, 0.204432940075298892414161999234649L, 0.209482141084727828012999174891714L};
+//gauss-7 weights for GK_X[1], GK_X[3], GK_X[5], GK_X[7]
+const ld G_W[4] = {0.129484966168869693270611432679082L, 0.279705391489276667901467771423780L, 0.381830050505118944950369775488975L, 0.417959183673469387755102040816327L};
+ 
+struct quad_piece {
+    ld a, b, val, err;
+ 
+    bool operator<(const quad_piece& o) const {
+        return err < o.err;
+    }
+};
+ 
+struct quad_result {
+    ld area, err;
+    ll evals;
+};
+ 
+quad_result solve_quad(const roun* cs, int m, ld tol = 1e-14, ll max_evals = 1000000) {
+    quad_result res = {0, 0, 0};
+    box bx = narrow_box(cs, m);
+    if (bx.maxx <= bx.minx || bx.maxy <= bx.miny) {
+        return res;
+    }
+    std::vector<ld> br = {bx.minx, bx.maxx};
+    for (int i = 0; i < m; ++i) {
+        br.push_back(cs[i].x - cs[i].r);
+        br.push_back(cs[i].x + cs[i].r);
+        for (int j = i + 1; j < m; ++j) {
+            ld dx = cs[j].x - cs[i].x, dy = cs[j].y - cs[i].y;
+            ld d = std::sqrt(dx * dx + dy * dy);
+            if (d >= cs[i].r + cs[j].r || d <= std::abs(cs[i].r - cs[j].r)) {
+                continue;
+            }
+            ld a = (d * d + cs[i].r * cs[i].r - cs[j].r * cs[j].r) / (2 * d);
+            ld h = std::sqrt(std::max<ld>(0, cs[i].r * cs[i].r - a * a));
+            br.push_back(cs[i].x + a * dx / d - h * dy / d);
+            br.push_back(cs[i].x + a * dx / d + h * dy / d);
+        }
+    }
+    std::sort(br.begin(), br.end());
+    //piece [p, q] of x, integrated over t in [ta, tb] of [0, 1]
+    auto gk = [&](ld p, ld q, ld ta, ld tb) {
+        ld c = (ta + tb) / 2, hw = (tb - ta) / 2, k = 0, g = 0;
+        for (int i = 0; i < 15; ++i) {
+            int id = i < 8 ? i : 14 - i;
+            ld t = c + (i < 8 ? -1 : 1) * hw * GK_X[id];
+            ld f = slice_len(cs, m, p + (q - p) * t * t * (3 - 2 * t)) * 6 * t * (1 - t) * (q - p);
+            k += GK_W[id] * f;
+            if (id % 2 == 1) {
+                g += G_W[id / 2] * f;
+            }
+        }
+        res.evals += 15;
+        return quad_piece{ta, tb, k * hw, std::abs(k - g) * hw};
+    };
+    std::vector<std::pair<ld, ld>> spans;
+    ld tot = 0, err = 0;
+    //one queue over all spans, worst error first
+    struct item {
+        quad_piece q;
+        int span;
+ 
+        bool operator<(const item& o) const {
+            return q < o.q;
+        }
+    };
+    std::priority_queue<item> work;
+    for (size_t i = 0; i + 1 < br.size(); ++i) {
+        ld p = std::max(br[i], bx.minx), q = std::min(br[i + 1], bx.maxx);
+        if (q <= p) {
+            continue;
+        }
+        spans.push_back({p, q});
+        quad_piece z = gk(p, q, 0, 1);
+        tot += z.val;
+        err += z.err;
+        work.push({z, (int)spans.size() - 1});
+    }
+    while (err > tol * std::max<ld>(std::abs(tot), 1e-300L) && res.evals < max_evals && !work.empty()) {
+        item it = work.top();
+        work.pop();
+        ld p = spans[it.span].first, q = spans[it.span].second, mid = (it.q.a + it.q.b) / 2;
+        quad_piece l = gk(p, q, it.q.a, mid), r = gk(p, q, mid, it.q.b);
+        tot += l.val + r.val - it.q.val;
+        err += l.err + r.err - it.q.err;
+        work.push({l, it.span});
+        work.push({r, it.span});
+    }
+    res.area = tot;
+    res.err = err;
+    return res;
+}
+
+//precision policies. the estimator below runs in box coordinates scaled by the longer box side,
+//so every type sees values of order 1. precision<T> picks the arithmetic at compile time.
+//measured on the task geometry against long double with the same 1e8 points (ns/sample, avx512, one thread):
+//  float       - 2.2 ns, |bias| ~ 1e-7, boundary points within a float ulp get misclassified
+//  double      - 3.3 ns, identical hit count to long double
+//  long double - reference, x87 only, the block loops stay scalar
+//  fixed32     - 5.4 ns, 16.16 with exact 64-bit squares, |bias| ~ 1e-5 from the 2^-16 grid the points snap to
+struct fixed32 {
+};
+ 
+template <class T>
+struct precision {
+    using val = T;
+    using acc = T;
+ 
+    static val from(ld x) {
+        return (T)x;
+    }
+ 
+    static val scale(double u, val w) {
+        return (T)u * w;
+    }
+ 
+    static acc sq(val x) {
+        return x * x;
+    }
+ 
+    static acc sq_from(ld r) {
+        return (T)(r * r);
+    }
+};
+ 
+template <>
+struct precision<fixed32> {
+    using val = int32_t;
+    using acc = int64_t;
+    static const int FRAC = 16;
+ 
+    static val from(ld x) {
+        return (val)std::llround(x * (1 << FRAC));
+    }
+ 
+    static val scale(double u, val w) {
+        return (val)(((int64_t)(u * 4294967296.0) * w) >> 32);
+    }
+ 
+    static acc sq(val x) {
+        return (acc)x * x;
+    }
+ 
+    static acc sq_from(ld r) {
+        return std::llround(r * r * ((ld)(1LL << (2 * FRAC))));
+    }
+};
+ 
+//one block of PREC_B unit points: scaled into the box, then tested against every circle without
+//branches. the loops run over the whole block (a fixed trip count) so they vectorize at -O2 for
+//every policy; only the first cnt results are counted
+const int PREC_B = 1024;
+ 
+template <class T>
+__attribute__((always_inline)) inline ll prec_block(const typename precision<T>::val* qx, const typename precision<T>::val* qy,
+                                                    const typename precision<T>::acc* r2, int m, const double* u, const double* v,
+                                                    typename precision<T>::val w, typename precision<T>::val h, int cnt) {
+    using P = precision<T>;
+    typename P::val x[PREC_B], y[PREC_B];
+    unsigned char in[PREC_B];
+    for (int t = 0; t < PREC_B; ++t) {
+        x[t] = P::scale(u[t], w);
+        y[t] = P::scale(v[t], h);
+        in[t] = 1;
+    }
+    for (int j = 0; j < m; ++j) {
+        for (int t = 0; t < PREC_B; ++t) {
+            in[t] &= P::sq(x[t] - qx[j]) + P::sq(y[t] - qy[j]) <= r2[j];
+        }
+    }
+    ll k = 0;
+    for (int t = 0; t < cnt; ++t) {
+        k += in[t];
+    }
+    return k;
+}
+ 
+template <class T>
+__attribute__((target("avx512f"))) ll prec_avx512(const typename precision<T>::val* qx, const typename precision<T>::val* qy,
+                                                  const typename precision<T>::acc* r2, int m, const double* u, const double* v,
+                                                  typename precision<T>::val w, typename precision<T>::val h, int cnt) {
+    return prec_block<T>(qx, qy, r2, m, u, v, w, h, cnt);
+}
+ 
+template <class T>
+__attribute__((target("avx2"))) ll prec_avx2(const typename precision<T>::val* qx, const typename precision<T>::val* qy,
+                                             const typename precision<T>::acc* r2, int m, const double* u, const double* v,
+                                             typename precision<T>::val w, typename precision<T>::val h, int cnt) {
+    return prec_block<T>(qx, qy, r2, m, u, v, w, h, cnt);
+}
+ 
+template <class T>
+ll prec_scalar(const typename precision<T>::val* qx, const typename precision<T>::val* qy,
+               const typename precision<T>::acc* r2, int m, const double* u, const double* v,
+               typename precision<T>::val w, typename precision<T>::val h, int cnt) {
+    return prec_block<T>(qx, qy, r2, m, u, v, w, h, cnt);
+}
+ 
+//points [from, to) come from lanes seeded by (seed, from), so every policy sees the same points
+template <class T>
+ll hits_prec(const roun* cs, int m, box bx, uint64_t seed, ll from, ll to) {
+    using P = precision<T>;
+    using val = typename P::val;
+    ld len = std::max(bx.maxx - bx.minx, bx.maxy - bx.miny);
+    std::vector<val> qx(m), qy(m);
+    std::vector<typename P::acc> r2(m);
+    for (int j = 0; j < m; ++j) {
+        qx[j] = P::from((cs[j].x - bx.minx) / len);
+        qy[j] = P::from((cs[j].y - bx.miny) / len);
+        r2[j] = P::sq_from(cs[j].r / len);
+    }
+    val w = P::from((bx.maxx - bx.minx) / len), h = P::from((bx.maxy - bx.miny) / len);
+    using fn = decltype(&prec_scalar<T>);
+    static const fn f = pick<fn>(prec_avx512<T>, prec_avx2<T>, prec_scalar<T>);
+    uint64_t sd = seed ^ (0x9E3779B97F4A7C15ULL * (from + 1));
+    lane_rng st = seed_lanes(splitmix(sd));
+    std::vector<double> u(PREC_B), v(PREC_B);
+    ll k = 0;
+    for (ll i = from; i < to; i += PREC_B) {
+        int cnt = std::min<ll>(PREC_B, to - i);
+        fill_uniform(st, u.data(), cnt);
+        fill_uniform(st, v.data(), cnt);
+        k += f(qx.data(), qy.data(), r2.data(), m, u.data(), v.data(), w, h, cnt);
+    }
+    return k;
+}
+ 
+template <class T>
+ld solve_prec(const roun* cs, int m, box bx, ll n, uint64_t seed, int threads = 0) {
+    if (bx.maxx <= bx.minx || bx.maxy <= bx.miny || n <= 0) {
+        return 0;
+    }
+    ll k = parallel_hits(n, threads, [&](ll from, ll to) {
+        return hits_prec<T>(cs, m, bx, seed, from, to);
+    });
+    return (bx.maxx - bx.minx) * (bx.maxy - bx.miny) * (ld)k / (ld)n;
+}
+ 
+template <class T>
+ld solve1_prec(roun a, roun b, roun c, ll n, uint64_t seed = 1, int threads = 0) {
+    roun cs[3] = {a, b, c};
+    return solve_prec<T>(cs, 3, narrow_box(cs, 3), n, seed, threads);
+}
+ 
+template <class T>
+ld solve2_prec(roun a, roun b, roun c, ll n, uint64_t seed = 1, int threads = 0) {
+    roun cs[3] = {a, b, c};
+    return solve_prec<T>(cs, 3, wide_box(cs, 3), n, seed, threads);
+}
+
+//variance reduction. both return the estimate and its variance
+struct estimate {
+    ld area, var;
+};
+ 
+//area of the disk (0, 0, r) below and left of (x, y): integral over t <= x of the part of the
+//chord [-h, h], h = sqrt(r^2 - t^2), below y. g is the antiderivative of h
+ld disk_quadrant(ld r, ld x, ld y) {
+    x = std::max(-r, std::min(r, x));
+    y = std::max(-r, std::min(r, y));
+    auto g = [r](ld t) {
+        return (t * std::sqrt(std::max<ld>(0, r * r - t * t)) + r * r * std::asin(t / r)) / 2;
+    };
+    //on [lo, hi] clipped at x: the whole chord (2h) or the chord below y (y + h)
+    auto seg = [&](ld lo, ld hi, bool whole) -> ld {
+        hi = std::min(hi, x);
+        if (hi <= lo) {
+            return 0;
+        }
+        return whole ? 2 * (g(hi) - g(lo)) : y * (hi - lo) + g(hi) - g(lo);
+    };
+    ld w = std::sqrt(std::max<ld>(0, r * r - y * y));
+    if (y >= 0) {
+        return seg(-r, -w, 1) + seg(-w, w, 0) + seg(w, r, 1);
+    }
+    return seg(-w, w, 0);
+}
+ 
+ld disk_box_area(const roun& c, box b) {
+    return disk_quadrant(c.r, b.maxx - c.x, b.maxy - c.y) - disk_quadrant(c.r, b.minx - c.x, b.maxy - c.y) -
+           disk_quadrant(c.r, b.maxx - c.x, b.miny - c.y) + disk_quadrant(c.r, b.minx - c.x, b.miny - c.y);
+}
+ 
+//importance sampling: the proposal is uniform on narrow box ∩ disk j for the disk that cuts the
+//most off the box; that region contains the intersection and its area is exact (disk_box_area).
+//uniform proposal q = 1 / |region|, so each hit weighs |region| and the variance is
+//|region|^2 p (1 - p) / n = (|region| A - A^2) / n, which only shrinks with the region.
+//(a disk or a lens alone never helps on the task geometry: all are larger than the narrow box.)
+//points are drawn in box ∩ bounding box of the disk and rejected outside the disk; attempt t of
+//point i uses its own key, so the result still does not depend on the thread count
+estimate solve_is(const roun* cs, int m, ll n, uint64_t seed, int threads = 0) {
+    box bx = narrow_box(cs, m);
+    if (bx.maxx <= bx.minx || bx.maxy <= bx.miny || n <= 0) {
+        return {0, 0};
+    }
+    ld best = (bx.maxx - bx.minx) * (bx.maxy - bx.miny);
+    int disk = -1;
+    for (int j = 0; j < m; ++j) {
+        ld s = disk_box_area(cs[j], bx);
+        if (s < best) {
+            best = s;
+            disk = j;
+        }
+    }
+    box pb = bx;
+    if (disk >= 0) {
+        const roun& d = cs[disk];
+        pb = {std::max(bx.minx, d.x - d.r), std::min(bx.maxx, d.x + d.r), std::max(bx.miny, d.y - d.r), std::min(bx.maxy, d.y + d.r)};
+    }
+    ll k = parallel_hits(n, threads, [&](ll from, ll to) {
+        ll k = 0;
+        for (ll i = from; i < to; ++i) {
+            ld x, y;
+            for (uint64_t t = 0;; ++t) {
+                philox g(seed + t * 0x9E3779B97F4A7C15ULL, i);
+                double u, v;
+                g.point(u, v);
+                x = pb.minx + (pb.maxx - pb.minx) * u;
+                y = pb.miny + (pb.maxy - pb.miny) * v;
+                if (disk < 0 || inside(cs + disk, 1, x, y)) {
+                    break;
+                }
+            }
+            k += inside(cs, m, x, y);
+        }
+        return k;
+    });
+    ld p = (ld)k / n;
+    return {best * p, best * best * p * (1 - p) / n};
+}
+ 
+//points inside the control set (x) and inside every circle (y)
+struct cv_counts {
+    ll x = 0, y = 0;
+ 
+    cv_counts& operator+=(const cv_counts& o) {
+        x += o.x;
+        y += o.y;
+        return *this;
+    }
+};
+ 
+//control variate: uniform points in bx, Y = |bx| [inside all], X = |bx| [inside every circle of ctrl].
+//E[X] = exact_area of ctrl (a single circle: pi r^2) as long as that region lies in bx.
+//returns mean(Y) - c (mean(X) - E[X]) with the optimal c = cov(Y, X) / var(X) from the same points
+estimate solve_cv(const roun* cs, int m, box bx, const std::vector<int>& ctrl, ll n, uint64_t seed, int threads = 0) {
+    if (bx.maxx <= bx.minx || bx.maxy <= bx.miny || n <= 1) {
+        return {0, 0};
+    }
+    std::vector<roun> cc;
+    for (int j : ctrl) {
+        cc.push_back(cs[j]);
+    }
+    ld ex = exact_area(cc.data(), cc.size());
+    //[all] implies [ctrl], so two counters give every moment
+    cv_counts k = parallel_hits(n, threads, [&](ll from, ll to) {
+        philox g(seed, from);
+        cv_counts r;
+        for (ll i = from; i < to; ++i) {
+            double u, v;
+            g.point(u, v);
+            ld x0 = bx.minx + (bx.maxx - bx.minx) * u, y0 = bx.miny + (bx.maxy - bx.miny) * v;
+            if (inside(cc.data(), cc.size(), x0, y0)) {
+                r.x++;
+                r.y += inside(cs, m, x0, y0);
+            }
+        }
+        return r;
+    });
+    ll kx = k.x, ky = k.y;
+    ld s = (bx.maxx - bx.minx) * (bx.maxy - bx.miny);
+    ld py = (ld)ky / n, px = (ld)kx / n;
+    //E[XY] = s^2 py because Y implies X
+    ld cov = s * s * (py - py * px), vx = s * s * px * (1 - px), vy = s * s * py * (1 - py);
+    ld c = vx > 0 ? cov / vx : 0;
+    ld area = s * py - c * (s * px - ex);
+    return {area, std::max<ld>(0, vy - c * cov) / n};
+}
+ 
+//wide box with the smallest circle as the control
+estimate solve2_cv(roun a, roun b, roun c, ll n, uint64_t seed = 1, int threads = 0) {
+    roun cs[3] = {a, b, c};
+    int ctrl = 0;
+    for (int j = 1; j < 3; ++j) {
+        if (cs[j].r < cs[ctrl].r) {
+            ctrl = j;
+        }
+    }
+    return solve_cv(cs, 3, wide_box(cs, 3), {ctrl}, n, seed, threads);
+}
+ 
+estimate solve1_is(roun a, roun b, roun c, ll n, uint64_t seed = 1, int threads = 0) {
+    roun cs[3] = {a, b, c};
+    return solve_is(cs, 3, n, seed, threads);
+}
+
+//quasi-random points. both generators compute the i-th point directly from i,
+//so skip-ahead (and splitting across threads) costs nothing
+ 
+//sobol in 2d (dims: van der corput, x + 1), gray code order, matousek linear scramble + digital shift.
+//2^32 points per seed
+struct sobol2 {
+    uint32_t v[2][32];
+    uint32_t sx, sy, x, y;
+    uint64_t i;
+ 
+    sobol2(uint64_t seed, uint64_t start = 0) {
+        uint32_t d[2][32];
+        for (int k = 0; k < 32; ++k) {
+            d[0][k] = 1u << (31 - k);
+            d[1][k] = k == 0 ? 1u << 31 : d[1][k - 1] ^ (d[1][k - 1] >> 1);
+        }
+        for (int t = 0; t < 2; ++t) {
+            //lower triangular matrix with unit diagonal: row b keeps digit b and mixes in random higher digits
+            uint32_t row[32];
+            for (int b = 0; b < 32; ++b) {
+                uint32_t hi = b == 31 ? 0 : ~0u << (b + 1);
+                row[b] = (1u << b) | ((uint32_t)splitmix(seed) & hi);
+            }
+            for (int k = 0; k < 32; ++k) {
+                v[t][k] = 0;
+                for (int b = 0; b < 32; ++b) {
+                    v[t][k] |= (uint32_t)__builtin_parity(row[b] & d[t][k]) << b;
+                }
+            }
+        }
+        sx = (uint32_t)splitmix(seed);
+        sy = (uint32_t)splitmix(seed);
+        skip(start);
+    }
+ 
+    void skip(uint64_t to) {
+        i = to;
+        uint64_t g = to ^ (to >> 1);
+        x = sx;
+        y = sy;
+        for (int k = 0; k < 32; ++k) {
+            if ((g >> k) & 1) {
+                x ^= v[0][k];
+                y ^= v[1][k];
+            }
+        }
+    }
+ 
+    void point(double& u, double& w) {
+        u = (x + 0.5) * 0x1p-32;
+        w = (y + 0.5) * 0x1p-32;
+        int c = __builtin_ctzll(++i);
+        if (c < 32) {
+            x ^= v[0][c];
+            y ^= v[1][c];
+        }
+    }
+};
+ 
+//halton in bases 2 and 3 with a random cranley-patterson shift
+struct halton2 {
+    double ox, oy;
+    uint64_t i;
+ 
+    halton2(uint64_t seed, uint64_t start = 0) : i(start) {
+        ox = unit(splitmix(seed));
+        oy = unit(splitmix(seed));
+    }
+ 
+    static double radical(uint64_t k, uint32_t b) {
+        double f = 1, r = 0;
+        while (k) {
+            f /= b;
+            r += f * (k % b);
+            k /= b;
+        }
+        return r;
+    }
+ 
+    void point(double& u, double& w) {
+        u = radical(i, 2) + ox;
+        w = radical(i, 3) + oy;
+        u -= u >= 1;
+        w -= w >= 1;
+        ++i;
+    }
+};
+ 
+enum sampler {
+    PRNG,
+    SOBOL,
+    HALTON
+};
+ 
+ld solve_qmc(const roun* cs, int m, box bx, ll n, sampler kind, uint64_t seed, int threads) {
+    if (kind == SOBOL) {
+        return solve_mt<sobol2>(cs, m, bx, n, seed, threads);
+    }
+    if (kind == HALTON) {
+        return solve_mt<halton2>(cs, m, bx, n, seed, threads);
+    }
+    return solve_mt<philox>(cs, m, bx, n, seed, threads);
+}
+ 
+ld solve1_qmc(roun a, roun b, roun c, ll n, sampler kind, uint64_t seed = 1, int threads = 0) {
+    roun cs[3] = {a, b, c};
+    return solve_qmc(cs, 3, narrow_box(cs, 3), n, kind, seed, threads);
+}
+ 
+ld solve2_qmc(roun a, roun b, roun c, ll n, sampler kind, uint64_t seed = 1, int threads = 0) {
+    roun cs[3] = {a, b, c};
+    return solve_qmc(cs, 3, wide_box(cs, 3), n, kind, seed, threads);
+}
+
+//stratified: split the box into quadrants level by level, throw away cells that are
+//exactly inside or outside the intersection and spend the samples on the boundary cells only
+ 
+//1 - cell inside every circle, -1 - outside some circle, 0 - straddles
+int classify1(const roun& c, box cell) {
+    ld nx = std::max(cell.minx, std::min(c.x, cell.maxx)) - c.x;
+    ld ny = std::max(cell.miny, std::min(c.y, cell.maxy)) - c.y;
+    ld r2 = c.r * c.r;
+    if (nx * nx + ny * ny > r2) {
+        return -1;
+    }
+    ld fx = std::max(std::abs(c.x - cell.minx), std::abs(c.x - cell.maxx));
+    ld fy = std::max(std::abs(c.y - cell.miny), std::abs(c.y - cell.maxy));
+    return fx * fx + fy * fy <= r2 ? 1 : 0;
+}
+ 
+int classify(const roun* cs, int m, box cell) {
+    bool all = 1;
+    for (int j = 0; j < m; ++j) {
+        int t = classify1(cs[j], cell);
+        if (t == -1) {
+            return -1;
+        }
+        all &= t == 1;
+    }
+    return all ? 1 : 0;
+}
+ 
+struct strat_result {
+    ld area, var;
+    ll cells;
+};
+ 
+//subdivision stops when the next level would leave fewer than per_cell samples per boundary cell
+strat_result solve_strat(const roun* cs, int m, box bx, ll n, uint64_t seed, int per_cell = 8) {
+    strat_result res = {0, 0, 0};
+    if (bx.maxx <= bx.minx || bx.maxy <= bx.miny || n <= 0) {
+        return res;
+    }
+    std::vector<box> cur = {bx}, nxt;
+    int c0 = classify(cs, m, bx);
+    if (c0 != 0) {
+        res.area = c0 == 1 ? (bx.maxx - bx.minx) * (bx.maxy - bx.miny) : 0;
+        return res;
+    }
+    for (int depth = 0; depth < 30 && (ll)cur.size() * 4 * per_cell <= n; ++depth) {
+        nxt.clear();
+        for (const box& q : cur) {
+            ld mx = (q.minx + q.maxx) / 2, my = (q.miny + q.maxy) / 2;
+            box ch[4] = {{q.minx, mx, q.miny, my}, {mx, q.maxx, q.miny, my}, {q.minx, mx, my, q.maxy}, {mx, q.maxx, my, q.maxy}};
+            for (const box& z : ch) {
+                int t = classify(cs, m, z);
+                if (t == 1) {
+                    res.area += (z.maxx - z.minx) * (z.maxy - z.miny);
+                } else if (t == 0) {
+                    nxt.push_back(z);
+                }
+            }
+        }
+        cur.swap(nxt);
+        if (cur.empty()) {
+            return res;
+        }
+    }
+    //boundary cells are all on the same level, so they share an area and split n evenly
+    philox g(seed);
+    ll cells = cur.size();
+    for (ll t = 0; t < cells; ++t) {
+        const box& q = cur[t];
+        ll cnt = n / cells + (t < n % cells);
+        if (cnt == 0) {
+            continue;
+        }
+        ll k = 0;
+        for (ll i = 0; i < cnt; ++i) {
+            double u, v;
+            g.point(u, v);
+            if (inside(cs, m, q.minx + (q.maxx - q.minx) * u, q.miny + (q.maxy - q.miny) * v)) {
+                k++;
+            }
+        }
+        ld s = (q.maxx - q.minx) * (q.maxy - q.miny);
+        ld p = (ld)k / cnt;
+        res.area += s * p;
+        res.var += s * s * p * (1 - p) / cnt;
+    }
+    res.cells = cells;
+    return res;
+}
+ 
+ld solve1_strat(roun a, roun b, roun c, ll n, uint64_t seed = 1) {
+    roun cs[3] = {a, b, c};
+    return solve_strat(cs, 3, narrow_box(cs, 3), n, seed).area;
+}
+ 
+ld solve2_strat(roun a, roun b, roun c, ll n, uint64_t seed = 1) {
+    roun cs[3] = {a, b, c};
+    return solve_strat(cs, 3, wide_box(cs, 3), n, seed).area;
+}
+
+//many circles. a uniform grid over the box keeps per cell only the circles whose boundary
+//crosses it, in reject_order: cells outside some circle reject at once, the rest test a short list
+struct circle_grid {
+    box bx;
+    int g;
+    std::vector<int> start, ids;
+    std::vector<char> dead;
+ 
+    circle_grid(const roun* cs, int m, box b, int g_, const std::vector<int>& order) : bx(b), g(g_), start(g_ * g_ + 1, 0), dead(g_ * g_, 0) {
+        ld cw = (bx.maxx - bx.minx) / g, ch = (bx.maxy - bx.miny) / g;
+        for (int cy = 0; cy < g; ++cy) {
+            for (int cx = 0; cx < g; ++cx) {
+                int id = cy * g + cx;
+                box cell = {bx.minx + cw * cx, bx.minx + cw * (cx + 1), bx.miny + ch * cy, bx.miny + ch * (cy + 1)};
+                size_t was = ids.size();
+                for (int i = 0; i < m; ++i) {
+                    int j = order[i];
+                    int t = classify1(cs[j], cell);
+                    if (t == -1) {
+                        dead[id] = 1;
+                        ids.resize(was);
+                        break;
+                    }
+                    if (t == 0) {
+                        ids.push_back(j);
+                    }
+                }
+                start[id + 1] = ids.size();
+            }
+        }
+    }
+ 
+    bool inside(const roun* cs, ld x, ld y) const {
+        int cx = std::min<int>(g - 1, (int)((x - bx.minx) / (bx.maxx - bx.minx) * g));
+        int cy = std::min<int>(g - 1, (int)((y - bx.miny) / (bx.maxy - bx.miny) * g));
+        int id = cy * g + cx;
+        if (dead[id]) {
+            return 0;
+        }
+        for (int t = start[id]; t < start[id + 1]; ++t) {
+            const roun& c = cs[ids[t]];
+            ld qx = x - c.x, qy = y - c.y;
+            if (qx * qx + qy * qy > c.r * c.r) {
+                return 0;
+            }
+        }
+        return 1;
+    }
+};
+ 
+//grid side is picked so that building it costs about as much as the sampling
+ld solve_many(const roun* cs, int m, box bx, ll n, uint64_t seed, int threads = 0) {
+    if (bx.maxx <= bx.minx || bx.maxy <= bx.miny || n <= 0 || m == 0) {
+        return 0;
+    }
+    int g = std::max(1, std::min(256, (int)std::sqrt((double)n / m)));
+    circle_grid grid(cs, m, bx, g, reject_order(cs, m, bx, seed));
+    ll k = parallel_hits(n, threads, [&](ll from, ll to) {
+        philox gen(seed, from);
+        ll k = 0;
+        for (ll i = from; i < to; ++i) {
+            double u, v;
+            gen.point(u, v);
+            k += grid.inside(cs, bx.minx + (bx.maxx - bx.minx) * u, bx.miny + (bx.maxy - bx.miny) * v);
+        }
+        return k;
+    });
+    return (bx.maxx - bx.minx) * (bx.maxy - bx.miny) * (ld)k / (ld)n;
+}
+ 
+ld solve1_n(const roun* cs, int m, ll n, uint64_t seed = 1, int threads = 0) {
+    return m ? solve_many(cs, m, narrow_box(cs, m), n, seed, threads) : 0;
+}
+ 
+ld solve2_n(const roun* cs, int m, ll n, uint64_t seed = 1, int threads = 0) {
+    return m ? solve_many(cs, m, wide_box(cs, m), n, seed, threads) : 0;
+}
+
+//multi-process: shard k of K covers philox indices [n k / K, n (k + 1) / K), so shards never
+//share points and their merge equals one big run. a shard writes a small binary partial
+//(written to .tmp and renamed, so a file on disk is always complete); spawn skips shards
+//that already have one, which is how an interrupted run resumes
+const uint64_t PARTIAL_MAGIC = 0x31524150544E4F4DULL;
+ 
+struct partial {
+    uint64_t magic, seed, from, to, n, hits;
+    double s, sum, sumsq;
+};
+ 
+partial run_shard(const roun* cs, int m, box bx, ll n, uint64_t seed, int k, int shards, int threads = 1) {
+    partial p;
+    std::memset(&p, 0, sizeof(p));
+    p.magic = PARTIAL_MAGIC;
+    p.seed = seed;
+    p.from = n * k / shards;
+    p.to = n * (k + 1) / shards;
+    p.n = n;
+    p.s = std::max<ld>(0, bx.maxx - bx.minx) * std::max<ld>(0, bx.maxy - bx.miny);
+    if (p.s > 0) {
+        ll len = p.to - p.from;
+        p.hits = parallel_hits(len, threads, [&](ll from, ll to) {
+            return hits_range<philox>(cs, m, bx, seed, p.from + from, p.from + to);
+        });
+    }
+    p.sum = p.s * p.hits;
+    p.sumsq = p.s * p.s * p.hits;
+    return p;
+}
+ 
+bool save_partial(const partial& p, const std::string& path) {
+    std::string tmp = path + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) {
+        return 0;
+    }
+    bool ok = std::fwrite(&p, sizeof(p), 1, f) == 1;
+    ok &= std::fclose(f) == 0;
+    return ok && std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+ 
+bool load_partial(const std::string& path, partial& p) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        return 0;
+    }
+    bool ok = std::fread(&p, sizeof(p), 1, f) == 1;
+    std::fclose(f);
+    return ok && p.magic == PARTIAL_MAGIC;
+}
+ 
+struct merged {
+    ld area, lo, hi;
+    ll samples, missing;
+};
+ 
+//missing counts points of [0, n) no shard covered; overlapping shards and ones whose range
+//is not inside [0, n) are skipped. samples == 0 means nothing usable was merged
+merged merge_partials(std::vector<partial> ps, ld conf = 0.95) {
+    merged r = {0, 0, 0, 0, 0};
+    ps.erase(std::remove_if(ps.begin(), ps.end(), [](const partial& p) {
+        return p.from > p.to || p.to > p.n;
+    }), ps.end());
+    if (ps.empty()) {
+        return r;
+    }
+    std::sort(ps.begin(), ps.end(), [](const partial& a, const partial& b) {
+        return a.from < b.from;
+    });
+    ld sum = 0, sumsq = 0;
+    uint64_t at = 0;
+    for (const partial& p : ps) {
+        if (p.from < at || p.seed != ps[0].seed || p.n != ps[0].n) {
+            continue;
+        }
+        r.missing += p.from - at;
+        at = p.to;
+        r.samples += p.to - p.from;
+        sum += p.sum;
+        sumsq += p.sumsq;
+    }
+    r.missing += ps[0].n - at;
+    if (r.samples == 0) {
+        return r;
+    }
+    ld mean = sum / r.samples;
+    ld var = r.samples > 1 ? std::max<ld>(0, sumsq - r.samples * mean * mean) / (r.samples - 1) : 0;
+    ld half = normal_quantile(conf) * std::sqrt(var / r.samples);
+    r.area = mean;
+    r.lo = mean - half;
+    r.hi = mean + half;
+    return r;
+}
+ 
+std::string shard_path(const std::string& dir, int k) {
+    return dir + "/shard_" + std::to_string(k) + ".bin";
+}
+ 
+int report_merge(const std::vector<std::string>& files, ld real) {
+    std::vector<partial> ps;
+    for (const std::string& f : files) {
+        partial p;
+        if (load_partial(f, p)) {
+            ps.push_back(p);
+        } else {
+            std::cerr << "skipping " << f << '\n';
+        }
+    }
+    merged r = merge_partials(ps);
+    if (r.samples == 0) {
+        std::cerr << "no usable partials\n";
+        return 1;
+    }
+    std::cout << "samples,missing,area,lo,hi,err\n";
+    std::cout << r.samples << "," << r.missing << "," << r.area << "," << r.lo << "," << r.hi << std::scientific << "," << std::abs(r.area - real) / real << std::fixed << '\n';
+    return r.missing != 0;
+}
+ 
+//one forked worker per missing shard, worker k pinned to cpu k mod ncpu so the kernel keeps
+//its memory on that node. returns the number of shards that failed
+int spawn_shards(const roun* cs, int m, box bx, ll n, uint64_t seed, int shards, const std::string& dir) {
+    long ncpu = std::max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+    std::vector<pid_t> kids;
+    int skipped = 0;
+    for (int k = 0; k < shards; ++k) {
+        //a partial left by a run with another seed, n or shard count is redone
+        partial old;
+        if (load_partial(shard_path(dir, k), old) && old.seed == seed && old.n == (uint64_t)n &&
+            old.from == (uint64_t)(n * k / shards) && old.to == (uint64_t)(n * (k + 1) / shards)) {
+            skipped++;
+            continue;
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            //pinning only helps locality, a shard that cannot be pinned still runs
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(k % ncpu, &set);
+            if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+                std::perror("sched_setaffinity");
+            }
+            partial p = run_shard(cs, m, bx, n, seed, k, shards);
+            _exit(save_partial(p, shard_path(dir, k)) ? 0 : 1);
+        }
+        if (pid > 0) {
+            kids.push_back(pid);
+        } else {
+            std::perror("fork");
+        }
+    }
+    int bad = shards - (int)kids.size() - skipped;
+    for (pid_t pid : kids) {
+        int st = 0;
+        waitpid(pid, &st, 0);
+        bad += !(WIFEXITED(st) && WEXITSTATUS(st) == 0);
+    }
+    return bad;
+}
+
+//other shapes: ellipses (semi-axes a, b, turned by phi) and convex polygons (vertices in either order).
+//each shape gives a tight bounding box and the boxes are intersected as in solve1. for sampling
+//everything is lowered to two kinds of constraints over box coordinates:
+//conic  A dx^2 + B dx dy + C dy^2 <= 1 with dx, dy from the center (circles and ellipses),
+//half-plane  nx x + ny y <= c (polygon edges); both run as branch-free passes over a block of points
+struct ellipse {
+    ld x, y, a, b, phi;
+};
+ 
+struct poly {
+    std::vector<std::pair<ld, ld>> v;
+};
+ 
+using shape = std::variant<roun, ellipse, poly>;
+ 
+box shape_box(const shape& sh) {
+    if (const roun* c = std::get_if<roun>(&sh)) {
+        return {c->x - c->r, c->x + c->r, c->y - c->r, c->y + c->r};
+    }
+    if (const ellipse* e = std::get_if<ellipse>(&sh)) {
+        ld cs = std::cos(e->phi), sn = std::sin(e->phi);
+        ld hx = std::sqrt(e->a * e->a * cs * cs + e->b * e->b * sn * sn);
+        ld hy = std::sqrt(e->a * e->a * sn * sn + e->b * e->b * cs * cs);
+        return {e->x - hx, e->x + hx, e->y - hy, e->y + hy};
+    }
+    const poly& p = std::get<poly>(sh);
+    box bx = {1e300L, -1e300L, 1e300L, -1e300L};
+    for (auto& q : p.v) {
+        bx = {std::min(bx.minx, q.first), std::max(bx.maxx, q.first), std::min(bx.miny, q.second), std::max(bx.maxy, q.second)};
+    }
+    return bx;
+}
+ 
+struct conic {
+    double x, y, a, b, c;
+};
+ 
+struct halfplane {
+    double nx, ny, c;
+};
+ 
+//shapes in coordinates relative to (ox, oy)
+void lower_shapes(const std::vector<shape>& sh, ld ox, ld oy, std::vector<conic>& qs, std::vector<halfplane>& hs) {
+    for (const shape& z : sh) {
+        if (const roun* c = std::get_if<roun>(&z)) {
+            qs.push_back({(double)(c->x - ox), (double)(c->y - oy), (double)(1 / (c->r * c->r)), 0, (double)(1 / (c->r * c->r))});
+        } else if (const ellipse* e = std::get_if<ellipse>(&z)) {
+            ld cs = std::cos(e->phi), sn = std::sin(e->phi), ia = 1 / (e->a * e->a), ib = 1 / (e->b * e->b);
+            qs.push_back({(double)(e->x - ox), (double)(e->y - oy), (double)(cs * cs * ia + sn * sn * ib), (double)(2 * cs * sn * (ia - ib)), (double)(sn * sn * ia + cs * cs * ib)});
+        } else {
+            const std::vector<std::pair<ld, ld>>& v = std::get<poly>(z).v;
+            int k = v.size();
+            ld area2 = 0;
+            for (int i = 0; i < k; ++i) {
+                area2 += v[i].first * v[(i + 1) % k].second - v[(i + 1) % k].first * v[i].second;
+            }
+            for (int i = 0; i < k; ++i) {
+                //walk counter-clockwise: inside is on the left of every edge
+                auto p = v[i], q = v[(i + 1) % k];
+                if (area2 < 0) {
+                    std::swap(p, q);
+                }
+                ld ex = q.first - p.first, ey = q.second - p.second;
+                ld px = p.first - ox, py = p.second - oy;
+                hs.push_back({(double)ey, (double)-ex, (double)(ey * px - ex * py)});
+            }
+        }
+    }
+}
+ 
+//largest block shape_hits takes; its callers step through their points in blocks of this size
+const int SHAPE_B = 1024;
+ 
+ll shape_hits(const std::vector<conic>& qs, const std::vector<halfplane>& hs, const double* x, const double* y, int cnt) {
+    assert(cnt >= 0 && cnt <= SHAPE_B);
+    unsigned char in[SHAPE_B];
+    std::fill(in, in + cnt, 1);
+    for (const conic& q : qs) {
+        for (int i = 0; i < cnt; ++i) {
+            double dx = x[i] - q.x, dy = y[i] - q.y;
+            in[i] &= q.a * dx * dx + q.b * dx * dy + q.c * dy * dy <= 1.0;
+        }
+    }
+    for (const halfplane& h : hs) {
+        for (int i = 0; i < cnt; ++i) {
+            in[i] &= h.nx * x[i] + h.ny * y[i] <= h.c;
+        }
+    }
+    ll k = 0;
+    for (int i = 0; i < cnt; ++i) {
+        k += in[i];
+    }
+    return k;
+}
+ 
+//points [from, to) come from lanes seeded by (seed, from): reproducible for a given seed and thread count
+ld solve_shapes(const std::vector<shape>& sh, ll n, uint64_t seed = 1, int threads = 0) {
+    if (sh.empty() || n <= 0) {
+        return 0;
+    }
+    box bx = shape_box(sh[0]);
+    for (const shape& z : sh) {
+        box q = shape_box(z);
+        bx = {std::max(bx.minx, q.minx), std::min(bx.maxx, q.maxx), std::max(bx.miny, q.miny), std::min(bx.maxy, q.maxy)};
+    }
+    if (bx.maxx <= bx.minx || bx.maxy <= bx.miny) {
+        return 0;
+    }
+    std::vector<conic> qs;
+    std::vector<halfplane> hs;
+    lower_shapes(sh, bx.minx, bx.miny, qs, hs);
+    double w = bx.maxx - bx.minx, h = bx.maxy - bx.miny;
+    ll k = parallel_hits(n, threads, [&](ll from, ll to) {
+        uint64_t sd = seed ^ (0x9E3779B97F4A7C15ULL * (from + 1));
+        lane_rng st = seed_lanes(splitmix(sd));
+        std::vector<double> x(SHAPE_B), y(SHAPE_B);
+        ll k = 0;
+        for (ll i = from; i < to; i += SHAPE_B) {
+            int cnt = std::min<ll>(SHAPE_B, to - i);
+            fill_uniform(st, x.data(), cnt);
+            fill_uniform(st, y.data(), cnt);
+            for (int j = 0; j < cnt; ++j) {
+                x[j] *= w;
+                y[j] *= h;
+            }
+            k += shape_hits(qs, hs, x.data(), y.data(), cnt);
+        }
+        return k;
+    });
+    return (bx.maxx - bx.minx) * (bx.maxy - bx.miny) * (ld)k / (ld)n;
+}
+
+//sample bank: points generated once into a file and mapped read-only afterwards.
+//layout: 64-byte header, then u[n] and v[n] (unit square, SoA), each starting on a 64-byte boundary.
+//the estimators read the mapping in place: instead of moving points into a box, circles are moved
+//into the unit square, where circle j becomes the conic (w^2 du^2 + h^2 dv^2) / r^2 <= 1
+const uint64_t BANK_MAGIC = 0x314B4E41424F4E4DULL;
+ 
+struct bank_header {
+    uint64_t magic, n, seed, u_off, v_off, pad[3];
+};
+ 
+bool make_bank(const std::string& path, ll n, uint64_t seed) {
+    if (n <= 0) {
+        return 0;
+    }
+    bank_header hd = {BANK_MAGIC, (uint64_t)n, seed, 64, 0, {0, 0, 0}};
+    hd.v_off = (hd.u_off + n * sizeof(double) + 63) / 64 * 64;
+    std::string tmp = path + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) {
+        return 0;
+    }
+    bool ok = std::fwrite(&hd, sizeof(hd), 1, f) == 1;
+    const ll B = 1 << 16;
+    std::vector<double> buf(B);
+    for (int t = 0; t < 2 && ok; ++t) {
+        lane_rng st = seed_lanes(seed + t);
+        ok &= std::fseek(f, t ? hd.v_off : hd.u_off, SEEK_SET) == 0;
+        for (ll i = 0; i < n && ok; i += B) {
+            ll cnt = std::min(B, n - i);
+            fill_uniform(st, buf.data(), cnt);
+            ok &= std::fwrite(buf.data(), sizeof(double), cnt, f) == (size_t)cnt;
+        }
+    }
+    ok &= std::fclose(f) == 0;
+    return ok && std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+ 
+struct sample_bank {
+    void* base = MAP_FAILED;
+    size_t len = 0;
+    const double* u = 0;
+    const double* v = 0;
+    ll n = 0;
+ 
+    explicit sample_bank(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat sb;
+        if (fstat(fd, &sb) == 0 && sb.st_size >= (off_t)sizeof(bank_header)) {
+            len = sb.st_size;
+            base = mmap(0, len, PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (base == MAP_FAILED) {
+            return;
+        }
+        const bank_header* hd = (const bank_header*)base;
+        //n is bounded by the file size first, so n * 8 cannot overflow; then u[n] must end
+        //before v starts, v[n] inside the file, and both arrays start on a 64-byte boundary
+        uint64_t bytes = hd->n <= len / sizeof(double) ? hd->n * sizeof(double) : UINT64_MAX;
+        if (hd->magic != BANK_MAGIC || bytes > len || hd->u_off < sizeof(bank_header) || hd->u_off % 64 || hd->v_off % 64 ||
+            hd->u_off > len || hd->v_off > len || hd->u_off + bytes > hd->v_off || hd->v_off + bytes > len) {
+            return;
+        }
+        madvise(base, len, MADV_SEQUENTIAL);
+        u = (const double*)((const char*)base + hd->u_off);
+        v = (const double*)((const char*)base + hd->v_off);
+        n = hd->n;
+    }
+ 
+    sample_bank(const sample_bank&) = delete;
+    sample_bank& operator=(const sample_bank&) = delete;
+ 
+    ~sample_bank() {
+        if (base != MAP_FAILED) {
+            munmap(base, len);
+        }
+    }
+};
+ 
+//the first n bank points (or all of them if n is larger)
+ld solve_bank(const roun* cs, int m, box bx, const sample_bank& bank, ll n, int threads = 0) {
+    n = std::min(n, bank.n);
+    if (bx.maxx <= bx.minx || bx.maxy <= bx.miny || n <= 0) {
+        return 0;
+    }
+    ld w = bx.maxx - bx.minx, h = bx.maxy - bx.miny;
+    std::vector<conic> qs;
+    std::vector<halfplane> hs;
+    for (int j = 0; j < m; ++j) {
+        ld r2 = cs[j].r * cs[j].r;
+        qs.push_back({(double)((cs[j].x - bx.minx) / w), (double)((cs[j].y - bx.miny) / h), (double)(w * w / r2), 0, (double)(h * h / r2)});
+    }
+    ll k = parallel_hits(n, threads, [&](ll from, ll to) {
+        ll k = 0;
+        for (ll i = from; i < to; i += SHAPE_B) {
+            k += shape_hits(qs, hs, bank.u + i, bank.v + i, std::min<ll>(SHAPE_B, to - i));
+        }
+        return k;
+    });
+    return w * h * (ld)k / n;
+}
+ 
+ld solve1_bank(roun a, roun b, roun c, const sample_bank& bank, ll n, int threads = 0) {
+    roun cs[3] = {a, b, c};
+    return solve_bank(cs, 3, narrow_box(cs, 3), bank, n, threads);
+}
+ 
+ld solve2_bank(roun a, roun b, roun c, const sample_bank& bank, ll n, int threads = 0) {
+    roun cs[3] = {a, b, c};
+    return solve_bank(cs, 3, wide_box(cs, 3), bank, n, threads);
+}
+
+//bit-sliced membership: plane j holds one bit per sample (64 samples per word) telling whether
+//circle j contains it. any boolean region is then a bitwise expression over the planes plus a
+//popcount, so union, difference, "exactly k of m" and so on all come from one set of samples
+struct hit_planes {
+    box bx;
+    int m;
+    ll n, words;
+    std::vector<uint64_t> bits;
+ 
+    //word w of plane j
+    const uint64_t* plane(int j) const {
+        return bits.data() + (size_t)j * words;
+    }
+};
+ 
+uint64_t plane_word_scalar(const double* x, const double* y, const circ& c) {
+    uint64_t r = 0;
+    for (int i = 0; i < 64; ++i) {
+        double qx = x[i] - c.x, qy = y[i] - c.y;
+        r |= (uint64_t)(qx * qx + qy * qy <= c.r2) << i;
+    }
+    return r;
+}
+ 
+__attribute__((target("avx2")))
+uint64_t plane_word_avx2(const double* x, const double* y, const circ& c) {
+    uint64_t r = 0;
+    __m256d cx = _mm256_set1_pd(c.x), cy = _mm256_set1_pd(c.y), r2 = _mm256_set1_pd(c.r2);
+    for (int i = 0; i < 64; i += 4) {
+        __m256d qx = _mm256_sub_pd(_mm256_loadu_pd(x + i), cx), qy = _mm256_sub_pd(_mm256_loadu_pd(y + i), cy);
+        __m256d d = _mm256_add_pd(_mm256_mul_pd(qx, qx), _mm256_mul_pd(qy, qy));
+        r |= (uint64_t)_mm256_movemask_pd(_mm256_cmp_pd(d, r2, _CMP_LE_OQ)) << i;
+    }
+    return r;
+}
+ 
+__attribute__((target("avx512f")))
+uint64_t plane_word_avx512(const double* x, const double* y, const circ& c) {
+    uint64_t r = 0;
+    __m512d cx = _mm512_set1_pd(c.x), cy = _mm512_set1_pd(c.y), r2 = _mm512_set1_pd(c.r2);
+    for (int i = 0; i < 64; i += 8) {
+        __m512d qx = _mm512_sub_pd(_mm512_loadu_pd(x + i), cx), qy = _mm512_sub_pd(_mm512_loadu_pd(y + i), cy);
+        __m512d d = _mm512_add_pd(_mm512_mul_pd(qx, qx), _mm512_mul_pd(qy, qy));
+        r |= (uint64_t)_mm512_cmp_pd_mask(d, r2, _CMP_LE_OQ) << i;
+    }
+    return r;
+}
+ 
+using plane_fn = uint64_t (*)(const double*, const double*, const circ&);
+ 
+//samples n points of bx (use a box that covers every region you will ask about, e.g. wide_box)
+hit_planes sample_planes(const roun* cs, int m, box bx, ll n, uint64_t seed) {
+    static const plane_fn word = pick<plane_fn>(plane_word_avx512, plane_word_avx2, plane_word_scalar);
+    hit_planes hp;
+    hp.bx = bx;
+    hp.m = m;
+    hp.n = n;
+    hp.words = (n + 63) / 64;
+    hp.bits.assign((size_t)m * hp.words, 0);
+    std::vector<circ> q(m);
+    for (int j = 0; j < m; ++j) {
+        q[j] = {(double)(cs[j].x - bx.minx), (double)(cs[j].y - bx.miny), (double)(cs[j].r * cs[j].r)};
+    }
+    double w = bx.maxx - bx.minx, h = bx.maxy - bx.miny;
+    lane_rng st = seed_lanes(seed);
+    const int B = 1024;
+    std::vector<double> x(B), y(B);
+    for (ll i = 0; i < n; i += B) {
+        fill_uniform(st, x.data(), B);
+        fill_uniform(st, y.data(), B);
+        for (int t = 0; t < B; ++t) {
+            x[t] *= w;
+            y[t] *= h;
+        }
+        for (ll wd = i / 64; wd < std::min(hp.words, (i + B) / 64); ++wd) {
+            int off = wd * 64 - i;
+            for (int j = 0; j < m; ++j) {
+                hp.bits[(size_t)j * hp.words + wd] = word(x.data() + off, y.data() + off, q[j]);
+            }
+        }
+    }
+    //samples past n in the last word do not exist
+    if (n % 64) {
+        for (int j = 0; j < m; ++j) {
+            hp.bits[(size_t)j * hp.words + hp.words - 1] &= (1ULL << (n % 64)) - 1;
+        }
+    }
+    return hp;
+}
+ 
+//f gets one word from each plane (w[j] for circle j) and returns the word of the region
+template <class F>
+ld region_area(const hit_planes& hp, F f) {
+    if (hp.n == 0) {
+        return 0;
+    }
+    std::vector<uint64_t> w(hp.m);
+    ll k = 0;
+    for (ll i = 0; i < hp.words; ++i) {
+        for (int j = 0; j < hp.m; ++j) {
+            w[j] = hp.plane(j)[i];
+        }
+        uint64_t r = f(w.data());
+        if (i == hp.words - 1 && hp.n % 64) {
+            r &= (1ULL << (hp.n % 64)) - 1;
+        }
+        k += __builtin_popcountll(r);
+    }
+    return (hp.bx.maxx - hp.bx.minx) * (hp.bx.maxy - hp.bx.miny) * (ld)k / hp.n;
+}
+ 
+//points inside exactly k of the m circles: a bit-sliced counter adds the planes 64 samples at a time
+ld exactly_k(const hit_planes& hp, int k) {
+    if (k < 0 || k > hp.m) {
+        return 0;
+    }
+    int nb = 1;
+    while ((1 << nb) <= hp.m) {
+        ++nb;
+    }
+    return region_area(hp, [&](const uint64_t* w) {
+        uint64_t cnt[32] = {0};
+        for (int j = 0; j < hp.m; ++j) {
+            uint64_t carry = w[j];
+            for (int b = 0; b < nb && carry; ++b) {
+                uint64_t t = cnt[b] & carry;
+                cnt[b] ^= carry;
+                carry = t;
+            }
+        }
+        uint64_t eq = ~0ULL;
+        for (int b = 0; b < nb; ++b) {
+            eq &= (k >> b) & 1 ? cnt[b] : ~cnt[b];
+        }
+        return eq;
+    });
+}
+
+//one stream of points, estimate reported at every checkpoint (at must be increasing).
+//var is the variance of the estimate itself, from welford over s * [point inside]
+struct checkpoint {
+    ll n;
+    ld area, err, var;
+};
+ 
+std::vector<checkpoint> progressive(const roun* cs, int m, box bx, const std::vector<ll>& at, ld real, uint64_t seed) {
+    std::vector<checkpoint> res;
+    ld s = std::max<ld>(0, bx.maxx - bx.minx) * std::max<ld>(0, bx.maxy - bx.miny);
+    lane_rng st = seed_lanes(seed);
+    const int B = 1024;
+    std::vector<double> buf(2 * B);
+    ld mean = 0, m2 = 0;
+    ll i = 0;
+    for (ll stop : at) {
+        for (; i < stop; ++i) {
+            if (i % B == 0) {
+                fill_uniform(st, buf.data(), 2 * B);
+            }
+            double u = buf[2 * (i % B)], v = buf[2 * (i % B) + 1];
+            ld val = inside(cs, m, bx.minx + (bx.maxx - bx.minx) * u, bx.miny + (bx.maxy - bx.miny) * v) ? s : 0;
+            ld d = val - mean;
+            mean += d / (i + 1);
+            m2 += d * (val - mean);
+        }
+        ld var = i > 1 ? m2 / (i - 1) / i : 0;
+        res.push_back({i, mean, std::abs(mean - real) / real, var});
+    }
+    return res;
+}
+
+//benchmark: every estimator on the narrow box, best of reps runs, one csv row per (estimator, threads, n).
+//rel_err against the exact area makes error-vs-time curves out of the same file
+void bench_one(std::ostream& out, const std::string& name, int threads, ll n, ld exact, const std::function<ld()>& f, int reps = 3) {
+    double best = 1e300;
+    ld area = 0;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        area = f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+    out << name << "," << threads << "," << n << "," << std::scientific << best << "," << n / best << "," << best / n * 1e9;
+    out << std::fixed << "," << area << std::scientific << "," << std::abs(area - exact) / exact << std::fixed << '\n';
+}
+ 
+void run_bench(std::ostream& out, roun a, roun b, roun c) {
+    roun cs[3] = {a, b, c};
+    box bx = narrow_box(cs, 3);
+    ld exact = exact_area(cs, 3);
+    int all = std::max(1u, std::thread::hardware_concurrency());
+    out << std::setprecision(6);
+    out << "estimator,threads,n,sec,samples_per_sec,ns_per_sample,area,rel_err\n";
+    for (ll n = 10000; n <= 10000000; n *= 10) {
+        bench_one(out, "rand_ld", 1, n, exact, [&]() {
+            srand(1);
+            return solve1(a, b, c, n);
+        });
+        bench_one(out, "simd", 1, n, exact, [&]() {
+            return solve_simd(cs, 3, bx, n, 1);
+        });
+        for (int t : std::set<int>{1, all}) {
+            bench_one(out, "philox_ld", t, n, exact, [&]() {
+                return solve_mt<philox>(cs, 3, bx, n, 1, t);
+            });
+        }
+        bench_one(out, "prec_float", 1, n, exact, [&]() {
+            return solve_prec<float>(cs, 3, bx, n, 1, 1);
+        });
+        bench_one(out, "prec_double", 1, n, exact, [&]() {
+            return solve_prec<double>(cs, 3, bx, n, 1, 1);
+        });
+        bench_one(out, "prec_fixed32", 1, n, exact, [&]() {
+            return solve_prec<fixed32>(cs, 3, bx, n, 1, 1);
+        });
+        bench_one(out, "sobol", 1, n, exact, [&]() {
+            return solve_qmc(cs, 3, bx, n, SOBOL, 1, 1);
+        });
+        bench_one(out, "halton", 1, n, exact, [&]() {
+            return solve_qmc(cs, 3, bx, n, HALTON, 1, 1);
+        });
+        bench_one(out, "strat", 1, n, exact, [&]() {
+            return solve_strat(cs, 3, bx, n, 1).area;
+        });
+        bench_one(out, "grid", 1, n, exact, [&]() {
+            return solve_many(cs, 3, bx, n, 1, 1);
+        });
+    }
+}
+
+//every mode with its arguments; max_args -1 means any number
+struct mode_info {
+    const char* name;
+    const char* args;
+    int min_args, max_args;
+};
+ 
+const mode_info MODES[] = {
+    {"", "", 0, 0},
+    {"rerun", "", 0, 0},
+    {"simd", "", 0, 0},
+    {"mt", "", 0, 0},
+    {"strat", "", 0, 0},
+    {"sobol", "", 0, 0},
+    {"halton", "", 0, 0},
+    {"seq", "", 0, 0},
+    {"vr", "", 0, 0},
+    {"quad", "", 0, 0},
+    {"sweep", "", 0, 0},
+    {"dim", "", 0, 0},
+    {"shard", "<k> <K> <n> <seed> <file>", 5, 5},
+    {"spawn", "<K> <n> <seed> <dir>", 4, 4},
+    {"merge", "<file>...", 1, -1},
+    {"bench", "[file]", 0, 1},
+    {"shapes", "", 0, 0},
+    {"mkbank", "<file> <n> <seed>", 3, 3},
+    {"bank", "<file>", 1, 1},
+    {"regions", "", 0, 0},
+    {"check", "", 0, 0},
+};
+ 
+//whole-string integer arguments; false instead of an exception on junk or overflow
+bool parse_ll(const char* s, ll& out) {
+    try {
+        size_t pos = 0;
+        out = std::stoll(s, &pos);
+        return s[pos] == 0;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+ 
+bool parse_u64(const char* s, uint64_t& out) {
+    try {
+        size_t pos = 0;
+        out = std::stoull(s, &pos);
+        return s[pos] == 0 && s[0] != '-';
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+ 
+int usage(const char* prog) {
+    std::cerr << "usage:\n";
+    for (const mode_info& md : MODES) {
+        std::cerr << "  " << prog << (*md.name ? " " : "") << md.name << (*md.args ? " " : "") << md.args << '\n';
+    }
+    return 2;
+}
+ 
+int main(int argc, char** argv) {
+    srand(1);
+    std::string mode = argc > 1 ? argv[1] : "";
+    const mode_info* md = std::find_if(std::begin(MODES), std::end(MODES), [&](const mode_info& q) {
+        return mode == q.name;
+    });
+    int nargs = std::max(argc - 2, 0);
+    if (md == std::end(MODES) || nargs < md->min_args || (md->max_args >= 0 && nargs > md->max_args)) {
+        return usage(argv[0]);
+    }
+    bool simd = mode == "simd", mt = mode == "mt", strat = mode == "strat";
+    sampler qmc = mode == "sobol" ? SOBOL : mode == "halton" ? HALTON : PRNG;
+    std::ios_base::sync_with_stdio(false);
+    std::cin.tie(NULL);
+    roun a;
+    a.x = 1.0;
+    a.y = 1.0;
+    a.r = 1.0;
+    roun b;
+    b.x = 1.5;
+    b.y = 2.0;
+    b.r = std::sqrt(5.0)/ 2.0;
+    roun c;
+    c.x = 2.0;
+    c.y = 1.5;
+    c.r = std::sqrt(5.0) / 2.0;
+    ld real = real_area();
+    std::cout << std::fixed << std::setprecision(5);
+    if (mode == "seq") {
+        std::cout << "box,rel,n,sec,area,lo,hi,err\n";
+        for (ld rel : {1e-2L, 1e-3L, 1e-4L}) {
+            seq_result r1 = solve1_seq(a, b, c, rel);
+            seq_result r2 = solve2_seq(a, b, c, rel);
+            for (int t = 0; t < 2; ++t) {
+                seq_result& r = t ? r2 : r1;
+                std::cout << (t ? "wide," : "narrow,") << std::scientific << rel << "," << r.n << "," << r.sec << std::fixed;
+                std::cout << "," << r.area << "," << r.lo << "," << r.hi << std::scientific << "," << std::abs(r.area - real) / real << std::fixed << '\n';
+            }
+        }
+        return 0;
+    }
+    if (mode == "vr") {
+        //same budget for every estimator: relative error and standard deviation
+        std::cout << "n,err_w,err_cv,err_n,err_is,sd_w,sd_cv,sd_n,sd_is\n" << std::scientific;
+        roun cs[3] = {a, b, c};
+        for (ll n = 1000; n <= 10000000; n *= 10) {
+            estimate w = {solve2_mt(a, b, c, n, n), 0}, nr = {solve1_mt(a, b, c, n, n), 0};
+            estimate cv = solve2_cv(a, b, c, n, n), is = solve1_is(a, b, c, n, n);
+            box bw = wide_box(cs, 3), bn = narrow_box(cs, 3);
+            ld sw = (bw.maxx - bw.minx) * (bw.maxy - bw.miny), sn = (bn.maxx - bn.minx) * (bn.maxy - bn.miny);
+            w.var = w.area * (sw - w.area) / n;
+            nr.var = nr.area * (sn - nr.area) / n;
+            std::cout << n;
+            for (estimate* e : {&w, &cv, &nr, &is}) {
+                std::cout << "," << std::abs(e->area - real) / real;
+            }
+            for (estimate* e : {&w, &cv, &nr, &is}) {
+                std::cout << "," << std::sqrt(e->var);
+            }
+            std::cout << '\n';
+        }
+        return 0;
+    }
+    if (mode == "quad") {
+        roun cs[3] = {a, b, c};
+        std::cout << "tol,area,err_est,evals,err\n" << std::scientific;
+        for (ld tol : {1e-6L, 1e-9L, 1e-12L, 1e-15L}) {
+            quad_result q = solve_quad(cs, 3, tol);
+            std::cout << tol << "," << std::setprecision(15) << q.area << std::setprecision(5) << "," << q.err << "," << q.evals << "," << std::abs(q.area - real) / real << '\n';
+        }
+        return 0;
+    }
+    if (mode == "sweep") {
+        //1000 triples with the third radius swept, one pool against separate runs
+        const int cfgs = 1000;
+        const ll n = 1000000;
+        std::vector<roun> cs;
+        for (int i = 0; i < cfgs; ++i) {
+            roun z = c;
+            z.r = c.r * (0.95 + 0.1 * i / cfgs);
+            cs.insert(cs.end(), {a, b, z});
+        }
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<ld> sw = solve_sweep(cs.data(), 3, cfgs, n, 1);
+        double t1 = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        t0 = std::chrono::steady_clock::now();
+        ld worst = 0, worst_sep = 0;
+        for (int i = 0; i < cfgs; ++i) {
+            ld sep = solve_simd(cs.data() + 3 * i, 3, narrow_box(cs.data() + 3 * i, 3), n, i + 1);
+            ld ex = exact_area(cs.data() + 3 * i, 3);
+            worst = std::max(worst, std::abs(sw[i] - ex) / ex);
+            worst_sep = std::max(worst_sep, std::abs(sep - ex) / ex);
+        }
+        double t2 = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << "configs,n,sweep_sec,separate_sec,max_err_sweep,max_err_separate\n";
+        std::cout << cfgs << "," << n << "," << t1 << "," << t2 << std::scientific << "," << worst << "," << worst_sep << '\n';
+        return 0;
+    }
+    if (mode == "dim") {
+        std::cout << "dim,n,sec,msamples_per_sec,ns_per_sample,vol_narrow,vol_strat,vol_ball\n";
+        dim_report<2>(10000000);
+        dim_report<3>(10000000);
+        dim_report<4>(10000000);
+        dim_report<6>(10000000);
+        dim_report<8>(10000000);
+        dim_report<12>(10000000);
+        dim_report<16>(10000000);
+        return 0;
+    }
+    if (mode == "shard") {
+        //shard <k> <K> <n> <seed> <file>, 0 <= k < K, n > 0
+        ll k, shards, n;
+        uint64_t seed;
+        if (!parse_ll(argv[2], k) || !parse_ll(argv[3], shards) || !parse_ll(argv[4], n) || !parse_u64(argv[5], seed) ||
+            shards <= 0 || shards > INT_MAX || k < 0 || k >= shards || n <= 0) {
+            return usage(argv[0]);
+        }
+        roun cs[3] = {a, b, c};
+        partial p = run_shard(cs, 3, narrow_box(cs, 3), n, seed, k, shards);
+        return save_partial(p, argv[6]) ? 0 : 1;
+    }
+    if (mode == "spawn") {
+        //spawn <K> <n> <seed> <dir>, then merge what is there; K > 0, n > 0
+        ll shards, n;
+        uint64_t seed;
+        if (!parse_ll(argv[2], shards) || !parse_ll(argv[3], n) || !parse_u64(argv[4], seed) || shards <= 0 || shards > INT_MAX || n <= 0) {
+            return usage(argv[0]);
+        }
+        roun cs[3] = {a, b, c};
+        int bad = spawn_shards(cs, 3, narrow_box(cs, 3), n, seed, shards, argv[5]);
+        if (bad != 0) {
+            std::cerr << "some shards failed, run again to resume\n";
+        }
+        std::vector<std::string> files;
+        for (int k = 0; k < shards; ++k) {
+            files.push_back(shard_path(argv[5], k));
+        }
+        int rc = report_merge(files, real);
+        return bad != 0 || rc != 0;
+    }
+    if (mode == "merge") {
+        //merge <file>...
+        return report_merge(std::vector<std::string>(argv + 2, argv + argc), real);
+    }
+    if (mode == "bench") {
+        //bench [file], bench.csv by default
+        std::ofstream out(argc > 2 ? argv[2] : "bench.csv");
+        run_bench(out, a, b, c);
+        return 0;
+    }
+    if (mode == "shapes") {
+        //known answers: circle as an ellipse, quarter of a unit square, disk inside a square, rotated ellipse area
+        const ld pi = 4 * std::atan((ld)1);
+        poly sq = {{{0, 0}, {1, 0}, {1, 1}, {0, 1}}};
+        poly moved = {{{0.5, 1.5}, {1.5, 1.5}, {1.5, 0.5}, {0.5, 0.5}}};
+        std::vector<std::pair<std::string, std::pair<std::vector<shape>, ld>>> cases = {
+            {"three_as_ellipses", {{ellipse{a.x, a.y, a.r, a.r, 0.3}, ellipse{b.x, b.y, b.r, b.r, 1}, ellipse{c.x, c.y, c.r, c.r, 2}}, real}},
+            {"square_square", {{sq, moved}, 0.25}},
+            {"square_disk", {{sq, roun{0.5, 0.5, 0.4}}, pi * 0.16}},
+            {"rotated_ellipse", {{ellipse{1, 2, 3, 0.5, 0.7}}, pi * 1.5}},
+        };
+        std::cout << "case,area,exact,err\n";
+        for (auto& t : cases) {
+            ld v = solve_shapes(t.second.first, 10000000);
+            std::cout << t.first << "," << v << "," << t.second.second << std::scientific << "," << std::abs(v - t.second.second) / t.second.second << std::fixed << '\n';
+        }
+        return 0;
+    }
+    if (mode == "mkbank") {
+        //mkbank <file> <n> <seed>
+        ll n;
+        uint64_t seed;
+        if (!parse_ll(argv[3], n) || !parse_u64(argv[4], seed)) {
+            return usage(argv[0]);
+        }
+        return make_bank(argv[2], n, seed) ? 0 : 1;
+    }
+    if (mode == "bank") {
+        //bank <file>: the rerun sweep, every n takes a prefix of the bank
+        sample_bank bank(argv[2]);
+        if (bank.n == 0) {
+            std::cerr << "bad bank " << argv[2] << '\n';
+            return 1;
+        }
+        std::cout << "n,area_n,area_w,disp_n,disp_w\n";
+        for (ll i = 100; i <= std::min<ll>(100000, bank.n); i += 500) {
+            ld s1 = solve1_bank(a, b, c, bank, i, 1), s2 = solve2_bank(a, b, c, bank, i, 1);
+            std::cout << i << "," << s1 << "," << s2 << "," << std::abs(s1 - real) / real << "," << std::abs(s2 - real) / real << '\n';
+        }
+        return 0;
+    }
+    if (mode == "regions") {
+        //one set of samples in the wide box, references from exact_area by inclusion-exclusion
+        roun cs[3] = {a, b, c};
+        hit_planes hp = sample_planes(cs, 3, wide_box(cs, 3), 10000000, 1);
+        roun ab[2] = {a, b}, ac[2] = {a, c}, bc[2] = {b, c};
+        ld t3 = exact_area(cs, 3), pab = exact_area(ab, 2), pac = exact_area(ac, 2), pbc = exact_area(bc, 2);
+        ld sa = exact_area(&a, 1), sb = exact_area(&b, 1), sc = exact_area(&c, 1);
+        std::vector<std::pair<std::string, std::pair<ld, ld>>> rows = {
+            {"A&B&C", {region_area(hp, [](const uint64_t* w) { return w[0] & w[1] & w[2]; }), t3}},
+            {"A|B|C", {region_area(hp, [](const uint64_t* w) { return w[0] | w[1] | w[2]; }), sa + sb + sc - pab - pac - pbc + t3}},
+            {"A&B\\C", {region_area(hp, [](const uint64_t* w) { return w[0] & w[1] & ~w[2]; }), pab - t3}},
+            {"exactly2", {exactly_k(hp, 2), pab + pac + pbc - 3 * t3}},
+            {"exactly1", {exactly_k(hp, 1), sa + sb + sc - 2 * (pab + pac + pbc) + 3 * t3}},
+        };
+        std::cout << "region,area,exact,err\n";
+        for (auto& r : rows) {
+            std::cout << r.first << "," << r.second.first << "," << r.second.second << std::scientific << "," << std::abs(r.second.first - r.second.second) / r.second.second << std::fixed << '\n';
+        }
+        return 0;
+    }
+    if (mode == "check") {
+        //random configurations, exact area against the estimators
+        std::cout << "m,exact,strat,narrow,err_strat,err_narrow\n";
+        philox g(12345);
+        for (int t = 0; t < 20; ++t) {
+            int m = 2 + t % 4;
+            std::vector<roun> cs(m);
+            for (roun& q : cs) {
+                double u, v;
+                g.point(u, v);
+                q.x = u;
+                q.y = v;
+                g.point(u, v);
+                q.r = 0.6 + u;
+            }
+            ld ex = exact_area(cs.data(), m);
+            ld st = solve_strat(cs.data(), m, narrow_box(cs.data(), m), 1000000, t + 1).area;
+            ld nr = solve_mt<philox>(cs.data(), m, narrow_box(cs.data(), m), 1000000, t + 1, 0);
+            std::cout << m << "," << ex << "," << st << "," << nr << std::scientific;
+            std::cout << "," << std::abs(st - ex) / ex << "," << std::abs(nr - ex) / ex << std::fixed << '\n';
+        }
+        return 0;
+    }
+    if (mode == "") {
+        roun cs[3] = {a, b, c};
+        std::vector<ll> at;
+        for (ll i = 100; i <= 100000; i += 500) {
+            at.push_back(i);
+        }
+        std::vector<checkpoint> pn = progressive(cs, 3, narrow_box(cs, 3), at, real, 1);
+        std::vector<checkpoint> pw = progressive(cs, 3, wide_box(cs, 3), at, real, 2);
+        std::cout << "n,area_n,area_w,disp_n,disp_w,var_n,var_w\n";
+        for (size_t i = 0; i < at.size(); ++i) {
+            std::cout << at[i] << "," << pn[i].area << "," << pw[i].area << "," << pn[i].err << "," << pw[i].err;
+            std::cout << std::scientific << "," << pn[i].var << "," << pw[i].var << std::fixed << '\n';
+        }
+        return 0;
+    }
+    //rerun: every n from scratch
     std::cout << "n,area_n,area_w,disp_n,disp_w\n";
     for (ll i = 100; i <= 100000; i += 500) {
-        ld s1 = solve1(a, b, c, i);
-        ld s2 = solve2(a, b, c, i);
+        ld s1 = simd ? solve1_simd(a, b, c, i, i) : mt ? solve1_mt(a, b, c, i, i) : strat ? solve1_strat(a, b, c, i, i) : qmc ? solve1_qmc(a, b, c, i, qmc, i) : solve1(a, b, c, i);
+        ld s2 = simd ? solve2_simd(a, b, c, i, i) : mt ? solve2_mt(a, b, c, i, i) : strat ? solve2_strat(a, b, c, i, i) : qmc ? solve2_qmc(a, b, c, i, qmc, i) : solve2(a, b, c, i);
         std::cout << i << "," << s1 << "," << s2 << "," << std::abs(s1 - real) / real << "," << std::abs(s2 - real) / real << '\n';
     }
 }
\ No newline at end of file
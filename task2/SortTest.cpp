@@ -11,6 +11,15 @@
 #include <iomanip>
 #include <random>
 #include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <functional>
+#include <climits>
+#include <cstdlib>
+#include <immintrin.h>
 
 using ll = long long;
 using ld = long double;
@@ -95,8 +104,623 @@ void combineSort(std::vector <int>& a, int l, int r, int threshold) {
     merge(a, l, m, r);
 }
 
+//merges src[l, m) and src[m, r) into dst[l, r)
+void mergeTo(const int* src, int* dst, int l, int m, int r) {
+    int i1 = l, i2 = m, k = l;
+    while (i1 < m && i2 < r) {
+        if (src[i1] <= src[i2]) {
+            dst[k++] = src[i1++];
+        } else {
+            dst[k++] = src[i2++];
+        }
+    }
+    while (i1 < m) {
+        dst[k++] = src[i1++];
+    }
+    while (i2 < r) {
+        dst[k++] = src[i2++];
+    }
+}
+void insertionSort(int* a, int l, int r) {
+    for (int i = l; i < r; ++i) {
+        int tmp = a[i];
+        int j = i - 1;
+        for (; j >= l && a[j] > tmp; j--) {
+            a[j + 1] = a[j];
+        }
+        a[j + 1] = tmp;
+    }
+}
+//merges sorted x[0, nx) and y[0, ny) into out
+using MergeKernel = void (*)(const int*, int, const int*, int, int*);
+
+//sorts a[l, r) and leaves the result in b if toB, otherwise in a; the other array is scratch.
+//halves are sorted into the array we are not merging into, so no level copies back
+void pingPongSort(int* a, int* b, int l, int r, int threshold, bool toB, void (*leaf)(int*, int, int) = insertionSort,
+                  MergeKernel kernel = nullptr) {
+    if (r - l <= threshold) {
+        if (toB) {
+            std::copy(a + l, a + r, b + l);
+        }
+        leaf(toB ? b : a, l, r);
+        return;
+    }
+    int m = (l + r) >> 1;
+    pingPongSort(a, b, l, m, threshold, !toB, leaf, kernel);
+    pingPongSort(a, b, m, r, threshold, !toB, leaf, kernel);
+    const int* src = toB ? a : b;
+    int* dst = toB ? b : a;
+    if (kernel) {
+        kernel(src + l, m - l, src + m, r - m, dst + l);
+    } else {
+        mergeTo(src, dst, l, m, r);
+    }
+}
+//combineSort with one scratch buffer for the whole sort; threshold 1 is plain mergeSort.
+//the buffer covers only [l, r): both arrays are indexed from l's position, i.e. from 0
+void pingPongCombineSort(std::vector <int>& a, int l, int r, int threshold) {
+    std::vector <int> buf(std::max(r - l, 0));
+    pingPongSort(a.data() + l, buf.data(), 0, r - l, std::max(threshold, 1), false);
+}
+
+//bitonic sorting networks on avx2 registers of 8 ints for leaves of up to 64 elements:
+//fixed sequences of min/max/shuffle with no data-dependent branches
+__attribute__((target("avx2")))
+inline __m256i reverse8(__m256i v) {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+//compares every lane with its partner p, keeps the min where mask bit is 0 and the max where it is 1
+#define CMP_STEP(v, p, mask) \
+    _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), mask)
+
+//sorts a bitonic register (half-cleaners at distance 4, 2, 1)
+__attribute__((target("avx2")))
+inline __m256i cleanReg(__m256i v) {
+    v = CMP_STEP(v, _mm256_permute2x128_si256(v, v, 1), 0xF0);
+    v = CMP_STEP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)), 0xCC);
+    return CMP_STEP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+}
+__attribute__((target("avx2")))
+inline __m256i sortReg(__m256i v) {
+    v = CMP_STEP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+    v = CMP_STEP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)), 0xCC);
+    v = CMP_STEP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+    v = CMP_STEP(v, reverse8(v), 0xF0);
+    v = CMP_STEP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)), 0xCC);
+    return CMP_STEP(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+}
+//sorts R (power of two) registers as one sequence: each register alone, then runs of k
+//registers are merged pairwise by a flip against the reversed partner run and half-cleaners
+__attribute__((target("avx2")))
+inline void sortRegs(__m256i* v, int R) {
+    for (int i = 0; i < R; ++i) {
+        v[i] = sortReg(v[i]);
+    }
+    for (int k = 1; k < R; k <<= 1) {
+        for (int s = 0; s < R; s += 2 * k) {
+            for (int i = 0; i < k; ++i) {
+                __m256i x = v[s + i], y = reverse8(v[s + 2 * k - 1 - i]);
+                v[s + i] = _mm256_min_epi32(x, y);
+                v[s + 2 * k - 1 - i] = reverse8(_mm256_max_epi32(x, y));
+            }
+            for (int d = k >> 1; d > 0; d >>= 1) {
+                for (int i = s; i < s + 2 * k; i += 2 * d) {
+                    for (int j = i; j < i + d; ++j) {
+                        __m256i x = v[j], y = v[j + d];
+                        v[j] = _mm256_min_epi32(x, y);
+                        v[j + d] = _mm256_max_epi32(x, y);
+                    }
+                }
+            }
+            for (int i = s; i < s + 2 * k; ++i) {
+                v[i] = cleanReg(v[i]);
+            }
+        }
+    }
+}
+//sorts a[l, r), r - l <= 64; the tail is padded with INT_MAX up to 8, 16, 32 or 64 elements
+__attribute__((target("avx2")))
+void networkSort(int* a, int l, int r) {
+    int n = r - l;
+    alignas(32) int buf[64];
+    std::copy(a + l, a + r, buf);
+    int R = 1;
+    while (8 * R < n) {
+        R <<= 1;
+    }
+    std::fill(buf + n, buf + 8 * R, INT_MAX);
+    __m256i v[8];
+    for (int i = 0; i < R; ++i) {
+        v[i] = _mm256_load_si256((const __m256i*)(buf + 8 * i));
+    }
+    sortRegs(v, R);
+    for (int i = 0; i < R; ++i) {
+        _mm256_store_si256((__m256i*)(buf + 8 * i), v[i]);
+    }
+    std::copy(buf, buf + n, a + l);
+}
+#undef CMP_STEP
+
+//the next output element is picked with a compare turned into index arithmetic instead of a
+//branch, so random data does not pay for mispredictions
+void mergeBranchless(const int* x, int nx, const int* y, int ny, int* out) {
+    int i = 0, j = 0;
+    while (i < nx && j < ny) {
+        int u = x[i], v = y[j];
+        bool takeY = v < u;
+        *out++ = takeY ? v : u;
+        i += !takeY;
+        j += takeY;
+    }
+    out = std::copy(x + i, x + nx, out);
+    std::copy(y + j, y + ny, out);
+}
+//8 elements at a time: the low half of the bitonic merge of two sorted registers is final,
+//the high half stays in a register and meets the next block from whichever run has the smaller head
+__attribute__((target("avx2")))
+void mergeAvx2(const int* x, int nx, const int* y, int ny, int* out) {
+    if (nx < 8 || ny < 8) {
+        mergeBranchless(x, nx, y, ny, out);
+        return;
+    }
+    __m256i hi = _mm256_loadu_si256((const __m256i*)x);
+    __m256i nxt = _mm256_loadu_si256((const __m256i*)y);
+    int i = 8, j = 8;
+    while (true) {
+        __m256i rev = reverse8(nxt);
+        __m256i lo = cleanReg(_mm256_min_epi32(hi, rev));
+        hi = cleanReg(_mm256_max_epi32(hi, rev));
+        _mm256_storeu_si256((__m256i*)out, lo);
+        out += 8;
+        if (i + 8 > nx || j + 8 > ny) {
+            break;
+        }
+        if (x[i] <= y[j]) {
+            nxt = _mm256_loadu_si256((const __m256i*)(x + i));
+            i += 8;
+        } else {
+            nxt = _mm256_loadu_si256((const __m256i*)(y + j));
+            j += 8;
+        }
+    }
+    //the 8 held back, a tail shorter than 8 and the rest of the other run
+    int held[8], tmp[16];
+    _mm256_storeu_si256((__m256i*)held, hi);
+    const int* shortRun = x + i;
+    const int* longRun = y + j;
+    int ns = nx - i, nl = ny - j;
+    if (ns > nl) {
+        std::swap(shortRun, longRun);
+        std::swap(ns, nl);
+    }
+    mergeBranchless(held, 8, shortRun, ns, tmp);
+    mergeBranchless(tmp, 8 + ns, longRun, nl, out);
+}
+
+//runtime dispatch: the avx2 variant when the cpu has it
+template <class F>
+F pick(F avx2, F scalar) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? avx2 : scalar;
+}
+
+using LeafSort = void (*)(int*, int, int);
+
+//ping-pong combineSort whose leaves (up to 64 elements) go to the sorting network and whose
+//merges go to the vector merge when avx2 is there
+void simdCombineSort(std::vector <int>& a, int l, int r, int threshold) {
+    static const LeafSort leaf = pick<LeafSort>(networkSort, insertionSort);
+    static const MergeKernel kernel = pick<MergeKernel>(mergeAvx2, mergeBranchless);
+    std::vector <int> buf(std::max(r - l, 0));
+    pingPongSort(a.data() + l, buf.data(), 0, r - l, std::min(std::max(threshold, 1), 64), false, leaf, kernel);
+}
+
+//fork/join pool: every worker owns a deque, pushes and pops its own tasks at the back and
+//steals from the front of the others when it runs dry. a thread waiting on a join keeps
+//running tasks instead of blocking, so nested forks never deadlock
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads) : queues(std::max(threads, 1)) {
+        for (int i = 1; i < (int)queues.size(); ++i) {
+            workers.emplace_back([this, i] {
+                self = {this, i};
+                while (true) {
+                    if (runOne(i)) {
+                        continue;
+                    }
+                    std::unique_lock<std::mutex> lk(sleepMu);
+                    if (stop) {
+                        return;
+                    }
+                    cv.wait(lk, [this] { return stop || queued.load() > 0; });
+                }
+            });
+        }
+    }
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lk(sleepMu);
+            stop = true;
+        }
+        cv.notify_all();
+        for (auto& t : workers) {
+            t.join();
+        }
+    }
+    int size() const {
+        return queues.size();
+    }
+    //a worker pushes to its own deque; any thread outside this pool (the owner, another pool's
+    //worker) goes through deque 0, which is shared and locked like the rest
+    void spawn(std::function<void()> f, std::atomic<int>& pending) {
+        pending++;
+        Queue& qu = queues[selfIndex()];
+        {
+            std::lock_guard<std::mutex> lk(qu.mu);
+            qu.q.push_back([f = std::move(f), &pending] {
+                f();
+                pending--;
+            });
+        }
+        queued++;
+        {
+            std::lock_guard<std::mutex> lk(sleepMu);
+        }
+        cv.notify_one();
+    }
+    void wait(std::atomic<int>& pending) {
+        while (pending.load() > 0) {
+            if (!runOne(selfIndex())) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    struct Queue {
+        std::mutex mu;
+        std::deque<std::function<void()>> q;
+    };
+    std::vector<Queue> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleepMu;
+    std::condition_variable cv;
+    std::atomic<int> queued{0};
+    bool stop = false;
+    struct Self {
+        const WorkStealingPool* pool;
+        int index;
+    };
+    static thread_local Self self;
+
+    int selfIndex() const {
+        return self.pool == this ? self.index : 0;
+    }
+
+    bool runOne(int id) {
+        std::function<void()> task;
+        for (int k = 0; k < (int)queues.size() && !task; ++k) {
+            Queue& qu = queues[(id + k) % queues.size()];
+            std::lock_guard<std::mutex> lk(qu.mu);
+            if (qu.q.empty()) {
+                continue;
+            }
+            if (k == 0) {
+                task = std::move(qu.q.back());
+                qu.q.pop_back();
+            } else {
+                task = std::move(qu.q.front());
+                qu.q.pop_front();
+            }
+        }
+        if (!task) {
+            return false;
+        }
+        queued--;
+        task();
+        return true;
+    }
+};
+thread_local WorkStealingPool::Self WorkStealingPool::self = {nullptr, 0};
+
+//how many of the first k merged elements come from x (ties go to x, as in merge)
+int coRank(const int* x, int nx, const int* y, int ny, int k) {
+    int lo = std::max(0, k - ny), hi = std::min(k, nx);
+    while (lo < hi) {
+        int i = (lo + hi + 1) >> 1;
+        if (x[i - 1] <= y[k - i]) {
+            lo = i;
+        } else {
+            hi = i - 1;
+        }
+    }
+    return lo;
+}
+//merge of src[l, m) and src[m, r) into dst[l, r), cut into output pieces that merge independently
+void parallelMerge(const int* src, int* dst, int l, int m, int r, WorkStealingPool& pool, int grain) {
+    const int* x = src + l;
+    const int* y = src + m;
+    int nx = m - l, ny = r - m, n = r - l;
+    int pieces = std::min((n + grain - 1) / grain, 4 * pool.size());
+    std::atomic<int> pending{0};
+    for (int p = 0; p < pieces; ++p) {
+        pool.spawn([=] {
+            int k0 = (ll)n * p / pieces, k1 = (ll)n * (p + 1) / pieces;
+            int i0 = coRank(x, nx, y, ny, k0), i1 = coRank(x, nx, y, ny, k1);
+            int j0 = k0 - i0, j1 = k1 - i1;
+            std::merge(x + i0, x + i1, y + j0, y + j1, dst + l + k0);
+        }, pending);
+    }
+    pool.wait(pending);
+}
+//pingPongSort with both halves forked as tasks and a co-ranked merge above the grain size
+void parallelSort(int* a, int* b, int l, int r, int threshold, bool toB, WorkStealingPool& pool, int grain) {
+    if (r - l <= grain) {
+        pingPongSort(a, b, l, r, threshold, toB);
+        return;
+    }
+    int m = (l + r) >> 1;
+    std::atomic<int> pending{0};
+    pool.spawn([=, &pool] { parallelSort(a, b, l, m, threshold, !toB, pool, grain); }, pending);
+    parallelSort(a, b, m, r, threshold, !toB, pool, grain);
+    pool.wait(pending);
+    if (toB) {
+        parallelMerge(a, b, l, m, r, pool, grain);
+    } else {
+        parallelMerge(b, a, l, m, r, pool, grain);
+    }
+}
+void parallelCombineSort(std::vector <int>& a, int l, int r, int threshold, WorkStealingPool& pool) {
+    std::vector <int> buf(std::max(r - l, 0));
+    parallelSort(a.data() + l, buf.data(), 0, r - l, std::max(threshold, 1), false, pool, 1 << 13);
+}
+
+//natural merge sort in the style of TimSort: sorted stretches already in the input are kept as
+//runs, so reversed and almost sorted arrays cost close to one linear pass
+struct Run {
+    int start, len;
+};
+//minimum run length in [32, 64] so that n / minRun is a power of two or slightly less
+int minRunLength(int n) {
+    int r = 0;
+    while (n >= 64) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+//a[l, start) is sorted; inserts the rest using binary search for the position (stable)
+void binaryInsertionSort(int* a, int l, int r, int start) {
+    for (int i = std::max(start, l + 1); i < r; ++i) {
+        int tmp = a[i];
+        int pos = std::upper_bound(a + l, a + i, tmp) - a;
+        std::copy_backward(a + pos, a + i, a + i + 1);
+        a[pos] = tmp;
+    }
+}
+//length of the run starting at l; a strictly descending run is reversed in place
+//(strict so that reversing never reorders equal elements)
+int countRun(int* a, int l, int r) {
+    int i = l + 1;
+    if (i == r) {
+        return 1;
+    }
+    if (a[i] < a[l]) {
+        while (i + 1 < r && a[i + 1] < a[i]) {
+            i++;
+        }
+        std::reverse(a + l, a + i + 1);
+    } else {
+        while (i + 1 < r && a[i + 1] >= a[i]) {
+            i++;
+        }
+    }
+    return i + 1 - l;
+}
+//number of elements of p[0, n) that are < key (or <= key if right), found by exponential
+//probing from the front and then binary search, so it is cheap when the answer is small
+int gallop(const int* p, int n, int key, bool right) {
+    auto before = [&](int v) { return right ? v <= key : v < key; };
+    int lo = 0, hi = 1;
+    while (hi <= n && before(p[hi - 1])) {
+        lo = hi;
+        hi = 2 * hi + 1;
+    }
+    hi = std::min(hi, n);
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (before(p[mid])) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+//merges the adjacent runs a[l, m) and a[m, r). elements already in place at either end are
+//skipped first; inside the merge, once one side wins minGallop times in a row we switch to
+//copying whole blocks found by gallop, and minGallop adapts to how well that pays off
+void mergeRuns(int* a, int l, int m, int r, std::vector <int>& tmp, int& minGallop) {
+    l += gallop(a + l, m - l, a[m], true);
+    if (l == m) {
+        return;
+    }
+    r = m + gallop(a + m, r - m, a[m - 1], false);
+    tmp.assign(a + l, a + m);
+    const int* x = tmp.data();
+    int nx = m - l, i = 0, j = m, k = l;
+    while (i < nx && j < r) {
+        int cx = 0, cy = 0;
+        while (i < nx && j < r) {
+            if (a[j] < x[i]) {
+                a[k++] = a[j++];
+                cy++;
+                cx = 0;
+            } else {
+                a[k++] = x[i++];
+                cx++;
+                cy = 0;
+            }
+            if (cx >= minGallop || cy >= minGallop) {
+                break;
+            }
+        }
+        while (i < nx && j < r) {
+            int g = gallop(x + i, nx - i, a[j], true);
+            k = std::copy(x + i, x + i + g, a + k) - a;
+            i += g;
+            if (i == nx) {
+                break;
+            }
+            int h = gallop(a + j, r - j, x[i], false);
+            k = std::copy(a + j, a + j + h, a + k) - a;
+            j += h;
+            if (g < 7 && h < 7) {
+                minGallop++;
+                break;
+            }
+            minGallop = std::max(1, minGallop - 1);
+        }
+    }
+    std::copy(x + i, x + nx, a + k);
+}
+void naturalMergeSort(std::vector <int>& a, int l, int r) {
+    int n = r - l;
+    if (n < 2) {
+        return;
+    }
+    int minRun = minRunLength(n);
+    int minGallop = 7;
+    std::vector <Run> runs;
+    std::vector <int> tmp;
+    auto mergeAt = [&](int i) {
+        mergeRuns(a.data(), runs[i].start, runs[i + 1].start, runs[i + 1].start + runs[i + 1].len, tmp, minGallop);
+        runs[i].len += runs[i + 1].len;
+        runs.erase(runs.begin() + i + 1);
+    };
+    for (int i = l; i < r;) {
+        int len = countRun(a.data(), i, r);
+        if (len < minRun) {
+            int ext = std::min(minRun, r - i);
+            binaryInsertionSort(a.data(), i, i + ext, i + len);
+            len = ext;
+        }
+        runs.push_back({i, len});
+        i += len;
+        //keep len[k - 2] > len[k - 1] + len[k] and len[k - 1] > len[k] for the top of the stack,
+        //which bounds the stack depth by log n and keeps merges balanced
+        while (runs.size() > 1) {
+            int k = runs.size() - 2;
+            if ((k > 0 && runs[k - 1].len <= runs[k].len + runs[k + 1].len) ||
+                (k > 1 && runs[k - 2].len <= runs[k - 1].len + runs[k].len)) {
+                if (runs[k - 1].len < runs[k + 1].len) {
+                    k--;
+                }
+            } else if (runs[k].len > runs[k + 1].len) {
+                break;
+            }
+            mergeAt(k);
+        }
+    }
+    while (runs.size() > 1) {
+        int k = runs.size() - 2;
+        if (k > 0 && runs[k - 1].len < runs[k + 1].len) {
+            k--;
+        }
+        mergeAt(k);
+    }
+}
+
+//keys min..max are counted and written back in order, O(n + range)
+void countingSort(std::vector <int>& a, int l, int r, int mn, int mx) {
+    std::vector <int> cnt((ll)mx - mn + 1);
+    for (int i = l; i < r; ++i) {
+        cnt[a[i] - mn]++;
+    }
+    int k = l;
+    for (int v = 0; v < (int)cnt.size(); ++v) {
+        std::fill(a.begin() + k, a.begin() + k + cnt[v], v + mn);
+        k += cnt[v];
+    }
+}
+//lsd radix sort on key - min with 11-bit digits; histograms of every pass come from one sweep,
+//passes above the highest set bit of the range are not run, nor ones where a single digit holds everything
+void radixSort(std::vector <int>& a, int l, int r, int mn, int mx) {
+    const int BITS = 11, SIZE = 1 << BITS;
+    int n = r - l;
+    unsigned range = (unsigned)mx - (unsigned)mn;
+    int passes = 0;
+    while (passes * BITS < 32 && (range >> (passes * BITS)) > 0) {
+        passes++;
+    }
+    std::vector <int> cnt(passes * SIZE);
+    for (int i = l; i < r; ++i) {
+        unsigned u = (unsigned)a[i] - (unsigned)mn;
+        for (int p = 0; p < passes; ++p) {
+            cnt[p * SIZE + ((u >> (p * BITS)) & (SIZE - 1))]++;
+        }
+    }
+    std::vector <int> buf(n);
+    int* src = a.data() + l;
+    int* dst = buf.data();
+    for (int p = 0; p < passes; ++p) {
+        int* c = cnt.data() + p * SIZE;
+        if (*std::max_element(c, c + SIZE) == n) {
+            continue;
+        }
+        int sum = 0;
+        for (int d = 0; d < SIZE; ++d) {
+            int t = c[d];
+            c[d] = sum;
+            sum += t;
+        }
+        for (int i = 0; i < n; ++i) {
+            unsigned u = (unsigned)src[i] - (unsigned)mn;
+            dst[c[(u >> (p * BITS)) & (SIZE - 1)]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    if (src != a.data() + l) {
+        std::copy(src, src + n, a.data() + l);
+    }
+}
+//non-comparison sort for ints: counting sort when the key range is small next to n, radix otherwise
+void integerSort(std::vector <int>& a, int l, int r) {
+    if (r - l < 2) {
+        return;
+    }
+    auto mm = std::minmax_element(a.begin() + l, a.begin() + r);
+    int mn = *mm.first, mx = *mm.second;
+    if ((ll)mx - mn < std::max<ll>(2LL * (r - l), 1 << 16)) {
+        countingSort(a, l, r, mn, mx);
+    } else {
+        radixSort(a, l, r, mn, mx);
+    }
+}
+
 class SortTester {
 public:
+    WorkStealingPool pool{(int)std::max(1u, std::thread::hardware_concurrency())};
+
+    //order-independent fingerprint of the values, catches a sort that loses or duplicates elements
+    static std::pair <ll, ll> fingerprint(const std::vector <int>& a) {
+        ll sum = 0;
+        unsigned long long mix = 0;
+        for (int x : a) {
+            unsigned long long h = (unsigned)x * 0x9E3779B97F4A7C15ULL;
+            sum += x;
+            mix += h ^ (h >> 29);
+        }
+        return {sum, (ll)mix};
+    }
+    //measures of the added sorts check their result outside the timed part, so a broken
+    //kernel stops the run instead of writing csv rows
+    static void verify(const std::vector <int>& a, const std::pair <ll, ll>& before, const char* name) {
+        if (!std::is_sorted(a.begin(), a.end()) || fingerprint(a) != before) {
+            std::cerr << name << ": wrong result on " << a.size() << " elements\n";
+            std::exit(1);
+        }
+    }
     ll measureMerge(std::vector <int>& a) {
         auto start = std::chrono::high_resolution_clock::now();
         mergeSort(a, 0, a.size());
@@ -118,6 +742,51 @@ public:
         long long msec = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
         return msec;
     }
+    ll measurePingPong(std::vector <int>& a, int threshold) {
+        std::pair <ll, ll> before = fingerprint(a);
+        auto start = std::chrono::high_resolution_clock::now();
+        pingPongCombineSort(a, 0, a.size(), threshold);
+        auto elapsed = std::chrono::high_resolution_clock::now() - start;
+        long long msec = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+        verify(a, before, "PingPong");
+        return msec;
+    }
+    ll measureNatural(std::vector <int>& a) {
+        std::pair <ll, ll> before = fingerprint(a);
+        auto start = std::chrono::high_resolution_clock::now();
+        naturalMergeSort(a, 0, a.size());
+        auto elapsed = std::chrono::high_resolution_clock::now() - start;
+        long long msec = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+        verify(a, before, "Natural");
+        return msec;
+    }
+    ll measureInteger(std::vector <int>& a) {
+        std::pair <ll, ll> before = fingerprint(a);
+        auto start = std::chrono::high_resolution_clock::now();
+        integerSort(a, 0, a.size());
+        auto elapsed = std::chrono::high_resolution_clock::now() - start;
+        long long msec = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+        verify(a, before, "Integer");
+        return msec;
+    }
+    ll measureSimd(std::vector <int>& a, int threshold) {
+        std::pair <ll, ll> before = fingerprint(a);
+        auto start = std::chrono::high_resolution_clock::now();
+        simdCombineSort(a, 0, a.size(), threshold);
+        auto elapsed = std::chrono::high_resolution_clock::now() - start;
+        long long msec = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+        verify(a, before, "Simd");
+        return msec;
+    }
+    ll measureParallel(std::vector <int>& a, int threshold) {
+        std::pair <ll, ll> before = fingerprint(a);
+        auto start = std::chrono::high_resolution_clock::now();
+        parallelCombineSort(a, 0, a.size(), threshold, pool);
+        auto elapsed = std::chrono::high_resolution_clock::now() - start;
+        long long msec = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+        verify(a, before, "Parallel");
+        return msec;
+    }
 };
 int main() {
     ArrayGenerator gen;
@@ -145,6 +814,26 @@ int main() {
         revOut << ",Combine_Th" << th;
         alOut << ",Combine_Th" << th;
     }
+    arOut << ",MergePP";
+    revOut << ",MergePP";
+    alOut << ",MergePP";
+    for (int th : thresholds) {
+        arOut << ",CombinePP_Th" << th;
+        revOut << ",CombinePP_Th" << th;
+        alOut << ",CombinePP_Th" << th;
+    }
+    arOut << ",Parallel_Th20";
+    revOut << ",Parallel_Th20";
+    alOut << ",Parallel_Th20";
+    arOut << ",Natural";
+    revOut << ",Natural";
+    alOut << ",Natural";
+    arOut << ",Integer";
+    revOut << ",Integer";
+    alOut << ",Integer";
+    arOut << ",CombineSimd_Th64";
+    revOut << ",CombineSimd_Th64";
+    alOut << ",CombineSimd_Th64";
     arOut << "\n";
     revOut << "\n";
     alOut << "\n";
@@ -165,6 +854,45 @@ int main() {
             revOut << "," << tes.measureCombine(subRev, th);
             alOut << "," << tes.measureCombine(subAl, th);
         }
+        subAr = std::vector<int>(ar.begin(), ar.begin() + size);
+        subRev = std::vector<int>(revAr.begin(), revAr.begin() + size);
+        subAl = std::vector<int>(alAr.begin(), alAr.begin() + size);
+        arOut << "," << tes.measurePingPong(subAr, 1);
+        revOut << "," << tes.measurePingPong(subRev, 1);
+        alOut << "," << tes.measurePingPong(subAl, 1);
+        for (int th : thresholds) {
+            subAr = std::vector<int>(ar.begin(), ar.begin() + size);
+            subRev = std::vector<int>(revAr.begin(), revAr.begin() + size);
+            subAl = std::vector<int>(alAr.begin(), alAr.begin() + size);
+
+            arOut << "," << tes.measurePingPong(subAr, th);
+            revOut << "," << tes.measurePingPong(subRev, th);
+            alOut << "," << tes.measurePingPong(subAl, th);
+        }
+        subAr = std::vector<int>(ar.begin(), ar.begin() + size);
+        subRev = std::vector<int>(revAr.begin(), revAr.begin() + size);
+        subAl = std::vector<int>(alAr.begin(), alAr.begin() + size);
+        arOut << "," << tes.measureParallel(subAr, 20);
+        revOut << "," << tes.measureParallel(subRev, 20);
+        alOut << "," << tes.measureParallel(subAl, 20);
+        subAr = std::vector<int>(ar.begin(), ar.begin() + size);
+        subRev = std::vector<int>(revAr.begin(), revAr.begin() + size);
+        subAl = std::vector<int>(alAr.begin(), alAr.begin() + size);
+        arOut << "," << tes.measureNatural(subAr);
+        revOut << "," << tes.measureNatural(subRev);
+        alOut << "," << tes.measureNatural(subAl);
+        subAr = std::vector<int>(ar.begin(), ar.begin() + size);
+        subRev = std::vector<int>(revAr.begin(), revAr.begin() + size);
+        subAl = std::vector<int>(alAr.begin(), alAr.begin() + size);
+        arOut << "," << tes.measureInteger(subAr);
+        revOut << "," << tes.measureInteger(subRev);
+        alOut << "," << tes.measureInteger(subAl);
+        subAr = std::vector<int>(ar.begin(), ar.begin() + size);
+        subRev = std::vector<int>(revAr.begin(), revAr.begin() + size);
+        subAl = std::vector<int>(alAr.begin(), alAr.begin() + size);
+        arOut << "," << tes.measureSimd(subAr, 64);
+        revOut << "," << tes.measureSimd(subRev, 64);
+        alOut << "," << tes.measureSimd(subAl, 64);
         arOut << "\n";
         revOut << "\n";
         alOut << "\n";